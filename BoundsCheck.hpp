@@ -0,0 +1,41 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/* Политики проверки индекса при чтении по [] / Get для DynamicArray,
+   LinkedList и последовательностей на них. Вставки и удаления по индексу
+   проверяются всегда: они и так O(n), а промах в них портит память.
+     CheckedBounds   — out_of_range (по умолчанию);
+     AssertBounds    — assert: ловит в отладочной сборке, с -DNDEBUG ничего не стоит;
+     UncheckedBounds — без проверки, для кода, который уже проверил диапазон. */
+
+/* холодный путь ошибки и подсказка ветвления; вне GCC/Clang — пусто */
+#if defined(__GNUC__)
+#define SEQ_COLD        __attribute__((noinline, cold))
+#define SEQ_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define SEQ_COLD
+#define SEQ_UNLIKELY(x) (x)
+#endif
+
+namespace detail {
+    // сообщение собирается только здесь: горячий код видит один вызов без std::string
+    [[noreturn]] SEQ_COLD
+    inline void ThrowIndexOutOfRange(size_t i, size_t n, const char* what = "size") {
+        throw std::out_of_range("IndexOutOfRange: index=" + std::to_string(i) + " " + what + "=" + std::to_string(n));
+    }
+}
+
+struct CheckedBounds {
+    static void Check(size_t i, size_t n, const char* what = "size") {
+        if (SEQ_UNLIKELY(i >= n)) detail::ThrowIndexOutOfRange(i, n, what);
+    }
+};
+struct AssertBounds {
+    static void Check(size_t i, size_t n, const char* = "size") { assert(i < n && "index out of range"); (void)i; (void)n; }
+};
+struct UncheckedBounds {
+    static void Check(size_t, size_t, const char* = "size") {}
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstddef>
+
+/* Позиция блочного обхода контейнера (NextChunk).
+   pos  — сколько элементов уже выдано;
+   node — служебная подсказка контейнера (следующий узел списка и т.п.).
+   Обход начинается с ChunkCursor{} и идёт, пока NextChunk возвращает true. */
+struct ChunkCursor {
+    const void* node = nullptr;
+    size_t      pos  = 0;
+};
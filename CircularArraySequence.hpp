@@ -0,0 +1,89 @@
+#pragma once
+#include "Sequence.hpp"
+#include "RingBuffer.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+/* Mutable-последовательность на кольцевом буфере:
+   Append/Prepend/PopBack/PopFront — O(1), Get — O(1). */
+template<typename T>
+class CircularArraySequence : public Sequence<T> {
+    RingBuffer<T> data_;
+public:
+    /* ctors */
+    CircularArraySequence() = default;
+    CircularArraySequence(const T* p,size_t n): data_(p,n) {}
+    CircularArraySequence(const CircularArraySequence&)            = default;
+    CircularArraySequence& operator=(const CircularArraySequence&) = default;
+    CircularArraySequence(CircularArraySequence&&) noexcept        = default;
+
+    /* read */
+    size_t GetLength()               const override { return data_.GetSize(); }
+    const T& Get(size_t i)           const override { return data_[i]; }
+    const T& GetFirst()              const override {
+        if (!GetLength()) throw std::out_of_range("empty");
+        return Get(0);
+    }
+    const T& GetLast()               const override {
+        if (!GetLength()) throw std::out_of_range("empty");
+        return Get(GetLength()-1);
+    }
+
+    /* mutable */
+    void Append (const T& v) override { data_.PushBack(v);  }
+    void Append (T&& v)      override { data_.PushBack(std::move(v));  }
+    void Prepend(const T& v) override { data_.PushFront(v); }
+    void Prepend(T&& v)      override { data_.PushFront(std::move(v)); }
+    void InsertAt(const T& v,size_t idx) override { data_.InsertAt(v,idx); }
+    void InsertAt(T&& v,size_t idx)      override { data_.InsertAt(std::move(v),idx); }
+    Sequence<T>* Concat(Sequence<T>* other) override {
+        size_t left = other->GetLength();          // other может оказаться нами самими
+        data_.Reserve(GetLength()+left);
+        other->ForEachChunk([&](const T* p, size_t n) {
+            n = std::min(n, left); left -= n;
+            for (size_t i=0;i<n;++i) data_.PushBack(p[i]);
+            return left > 0;
+        });
+        return this;
+    }
+    T PopBack()  override { return data_.PopBack();  }
+    T PopFront() override { return data_.PopFront(); }
+    T RemoveAt(size_t idx) override { return data_.RemoveAt(idx); }
+    void EraseRange(size_t l,size_t r) override { data_.Erase(l,r); }
+
+    // immutable versions are not supported, как и у MutableArraySequence
+    SeqUPtr<T> Append(const T&) const override {
+        throw std::logic_error("CircularArraySequence: immutable operation not supported");
+    }
+    SeqUPtr<T> Prepend(const T&) const override {
+        throw std::logic_error("CircularArraySequence: immutable operation not supported");
+    }
+    SeqUPtr<T> InsertAt(const T&, size_t) const override {
+        throw std::logic_error("CircularArraySequence: immutable operation not supported");
+    }
+    SeqUPtr<T> Concat(const Sequence<T>*) const override {
+        throw std::logic_error("CircularArraySequence: immutable operation not supported");
+    }
+
+    /* service */
+    SeqUPtr<T> GetSubsequence(size_t l,size_t r) const override {
+        if (l>r || r>=GetLength()) throw std::out_of_range("subseq: bad range");
+        auto res = std::make_unique<CircularArraySequence>();
+        res->data_.Reserve(r-l+1);
+        for (size_t i=l;i<=r;++i) res->data_.PushBack(data_[i]);
+        return res;
+    }
+    SeqUPtr<T> Clone() const override {
+        return SeqUPtr<T>(new CircularArraySequence(*this));
+    }
+    Sequence<T>* Instance() override { return this; }
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const override {
+        return data_.NextChunk(c,p,n);
+    }
+
+    auto begin()       { return data_.begin(); }
+    auto end()         { return data_.end(); }
+    auto begin() const { return data_.begin(); }
+    auto end()   const { return data_.end(); }
+};
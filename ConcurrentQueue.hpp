@@ -0,0 +1,153 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+/* Ограниченные lock-free очереди со словарём Queue.hpp:
+   Enqueue/Dequeue (ждут, пока не получится) и TryEnqueue/TryDequeue (не ждут).
+   Ёмкость округляется вверх до степени двойки. */
+
+constexpr size_t kCacheLineSize = 64;
+
+namespace detail {
+    inline size_t RoundUpPow2(size_t n) {
+        if (n < 2) n = 2;
+        size_t c = 1; while (c < n) c <<= 1;
+        return c;
+    }
+}
+
+/* ---------- один производитель / один потребитель ---------- */
+template<class T>
+class SpscQueue {
+private:
+    const size_t mask;
+    std::unique_ptr<T[]> data;
+
+    // head пишет только потребитель, tail — только производитель;
+    // у каждой стороны свой кэш чужого индекса, чтобы реже трогать чужую линию
+    alignas(kCacheLineSize) std::atomic<size_t> head{0};
+    size_t cachedTail = 0;
+    alignas(kCacheLineSize) std::atomic<size_t> tail{0};
+    size_t cachedHead = 0;
+
+public:
+    explicit SpscQueue(size_t capacity)
+        : mask(detail::RoundUpPow2(capacity) - 1), data(new T[mask + 1]) {}
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    bool TryEnqueue(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead > mask) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead > mask) return false;
+        }
+        data[t & mask] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    bool TryDequeue(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) return false;
+        }
+        out = std::move(data[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    void Enqueue(const T& item) { while (!TryEnqueue(item)) std::this_thread::yield(); }
+    T Dequeue() {
+        T item;
+        while (!TryDequeue(item)) std::this_thread::yield();
+        return item;
+    }
+    // при конкурентной работе — только оценка; head читается первым: потребитель
+    // мог уйти вперёд, но tail от этого не меньше head
+    size_t Size() const {
+        size_t h = head.load(std::memory_order_acquire);
+        size_t t = tail.load(std::memory_order_acquire);
+        return t > h ? t - h : 0;
+    }
+    size_t Capacity() const { return mask + 1; }
+};
+
+/* ---------- много производителей / много потребителей ----------
+   Ограниченная очередь Вьюкова: у каждой ячейки свой номер последовательности.
+   seq == pos      — ячейка свободна для записи с позиции pos;
+   seq == pos + 1  — в ячейке лежит элемент для чтения с позиции pos. */
+template<class T>
+class MpmcQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+    const size_t mask;
+    std::unique_ptr<Cell[]> cells;
+
+    alignas(kCacheLineSize) std::atomic<size_t> enqueuePos{0};
+    alignas(kCacheLineSize) std::atomic<size_t> dequeuePos{0};
+
+public:
+    explicit MpmcQueue(size_t capacity)
+        : mask(detail::RoundUpPow2(capacity) - 1), cells(new Cell[mask + 1]) {
+        for (size_t i = 0; i <= mask; ++i) cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    bool TryEnqueue(const T& item) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;                                   // полна
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = item;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+    bool TryDequeue(T& out) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;                                   // пуста
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->value);
+        cell->seq.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+    void Enqueue(const T& item) { while (!TryEnqueue(item)) std::this_thread::yield(); }
+    T Dequeue() {
+        T item;
+        while (!TryDequeue(item)) std::this_thread::yield();
+        return item;
+    }
+    // при конкурентной работе — только оценка
+    size_t Size() const {
+        size_t e = enqueuePos.load(std::memory_order_acquire);
+        size_t d = dequeuePos.load(std::memory_order_acquire);
+        return e > d ? e - d : 0;
+    }
+    size_t Capacity() const { return mask + 1; }
+};
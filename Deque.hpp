@@ -1,39 +1,41 @@
 #pragma once
 #include "Sequence.hpp"
-#include "MutableArraySequence.hpp"
+#include "CircularArraySequence.hpp"
+#include "Stats.hpp"
 #include <cassert>
 #include <iostream>
 
+/* с -DSEQ_STATS Stats() считает вставки, снятия и снятия, перестроившие хранилище */
 template<class T>
-class Deque {
+class Deque : protected stats::Counters<stats::AdapterKind> {
+    using K = stats::AdapterKind;
 private:
     std::unique_ptr<Sequence<T>> seq;
 public:
-    Deque() : seq(new MutableArraySequence<T>()) {}
-    void PushBack(const T& item) { seq->Append(item); }
-    void PushFront(const T& item) { seq->Prepend(item); }
+    Deque() : seq(new CircularArraySequence<T>()) {}
+    void PushBack(const T& item) { Add(K::Pushes); seq->Append(item); }
+    void PushBack(T&& item)      { Add(K::Pushes); seq->Append(std::move(item)); }
+    void PushFront(const T& item) { Add(K::Pushes); seq->Prepend(item); }
+    void PushFront(T&& item)      { Add(K::Pushes); seq->Prepend(std::move(item)); }
+    template<class... A> void EmplaceBack(A&&... a)  { Add(K::Pushes); seq->EmplaceBack(std::forward<A>(a)...); }
+    template<class... A> void EmplaceFront(A&&... a) { Add(K::Pushes); seq->EmplaceFront(std::forward<A>(a)...); }
+    const T& Front() const {
+        assert(seq->GetLength() > 0);
+        return seq->GetFirst();
+    }
+    const T& Back() const {
+        assert(seq->GetLength() > 0);
+        return seq->GetLast();
+    }
     T PopBack() {
         assert(seq->GetLength() > 0);
-        size_t idx = seq->GetLength() - 1;
-        T item = seq->Get(idx);
-        if (idx > 0) {
-            seq = seq->GetSubsequence(0, idx - 1);
-        } else {
-            seq.reset(new MutableArraySequence<T>());
-        }
-        return item;
+        return stats::CountPop(*this, [this] { return seq->PopBack(); });
     }
     T PopFront() {
         assert(seq->GetLength() > 0);
-        T item = seq->Get(0);
-        size_t len = seq->GetLength();
-        if (len > 1) {
-            seq = seq->GetSubsequence(1, len - 1);
-        } else {
-            seq.reset(new MutableArraySequence<T>());
-        }
-        return item;
+        return stats::CountPop(*this, [this] { return seq->PopFront(); });
     }
+    using stats::Counters<K>::Stats;
     size_t Size() const { return seq->GetLength(); }
     void Print() const {
         size_t n = seq->GetLength();
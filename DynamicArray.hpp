@@ -1,75 +1,341 @@
 #pragma once
+#include "BoundsCheck.hpp"
+#include "ChunkCursor.hpp"
+#include "Stats.hpp"
+#include "MappedFile.hpp"
 #include <memory>
 #include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
+
+/* --- growth policies: следующая ёмкость, когда места не хватило --- */
+struct GrowDouble {
+    static size_t Next(size_t cap) { return cap ? cap*2 : 1; }
+};
+struct GrowOneAndHalf {             // старые блоки можно переиспользовать аллокатором
+    static size_t Next(size_t cap) { return cap < 2 ? cap+1 : cap + cap/2; }
+};
+
+/* Хранилище — сырая память: элементы [0, size_) сконструированы,
+   [size_, capacity_) — нет. T не обязан иметь конструктор по умолчанию
+   (кроме Resize / DynamicArray(n)). Bounds — проверка индекса в []
+   (BoundsCheck.hpp); GetUnchecked / data() не проверяют никогда.
+   С -DSEQ_STATS Stats() считает Reserve, перевыделения при росте, байты,
+   сдвинутые и перенесённые между буферами, и пиковую ёмкость (Stats.hpp).
+   Mapped(path) — массив тривиально копируемых T прямо в файле (MappedFile.hpp):
+   открытие за O(1), рост без копирования (ftruncate + mremap), длина в файле
+   обновляется при Checkpoint и при разрушении. Копия такого массива — обычная,
+   в куче; массив над ReadOnly-файлом при росте тоже переезжает в кучу. */
+template<typename T, typename Growth = GrowDouble, typename Bounds = CheckedBounds>
+class DynamicArray : protected stats::Counters<stats::ArrayKind> {
+    using K = stats::ArrayKind;
 
-template<typename T>
-class DynamicArray {
     size_t size_     = 0;
     size_t capacity_ = 0;
-    std::unique_ptr<T[]> data_;
+    T*     data_     = nullptr;
+    std::unique_ptr<mapped::File> file_;         // nullptr — память из кучи
+
+    static constexpr bool kTrivial = std::is_trivially_copyable_v<T>;
+
+    void check(size_t i) const { if (i >= size_) detail::ThrowIndexOutOfRange(i, size_); }
+
+    static T*   allocate(size_t n)        { return n ? std::allocator<T>().allocate(n) : nullptr; }
+    static void deallocate(T* p,size_t n) { if(p) std::allocator<T>().deallocate(p, n); }
+
+    // отпустить текущий буфер: куча — освободить, файл — записать длину и закрыть
+    void release(){
+        if(file_){ file_->SetSize(size_); file_.reset(); }
+        else deallocate(data_, capacity_);
+    }
+    // файл растёт на месте; false — буфер не в файле (или файл только для чтения)
+    bool growMapped(size_t cap){
+        if(!file_ || !file_->Writable()) return false;
+        file_->Grow(mapped::File::kHeader + cap*sizeof(T));
+        data_ = static_cast<T*>(file_->Elements());
+        capacity_ = cap;
+        Max(K::PeakCapacity, cap);
+        return true;
+    }
 
-    void check(size_t i) const {
-        if (i >= size_)
-            throw std::out_of_range("IndexOutOfRange: index=" + std::to_string(i) +
-                                    " size="  + std::to_string(size_));
+    // новый буфер на cap: why — Reserves или Regrowths, size_ элементов переезжают
+    void noteRealloc(int why,size_t cap) const {
+        Add(why);
+        Add(K::BytesMoved, size_*sizeof(T));
+        Max(K::PeakCapacity, cap);
     }
 
+    // перенос n живых элементов в неинициализированную память dst
+    static void relocate(T* src,size_t n,T* dst){
+        if constexpr (kTrivial) {
+            if(n) std::memcpy(static_cast<void*>(dst), src, n*sizeof(T));
+        } else {
+            for(size_t i=0;i<n;++i){
+                ::new (static_cast<void*>(dst+i)) T(std::move_if_noexcept(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+    // сдвиг живых [from, size_) на место [to, ...), to < from; хвост разрушается
+    void shiftLeft(size_t from,size_t to){
+        size_t gap = from-to;
+        Add(K::BytesMoved, (size_-from)*sizeof(T));
+        if constexpr (kTrivial) {
+            std::memmove(static_cast<void*>(data_+to), data_+from, (size_-from)*sizeof(T));
+        } else {
+            std::move(data_+from, data_+size_, data_+to);
+            std::destroy(data_+size_-gap, data_+size_);
+        }
+        size_ -= gap;
+    }
+    // [i, size_) переезжает на k вправо, [i, i+k) остаются сырыми; ёмкости хватает
+    void openGap(size_t i,size_t k){
+        Add(K::BytesMoved, (size_-i)*sizeof(T));
+        if constexpr (kTrivial) {
+            std::memmove(static_cast<void*>(data_+i+k), data_+i, (size_-i)*sizeof(T));
+        } else {
+            for(size_t j=size_;j>i;--j){
+                ::new (static_cast<void*>(data_+j-1+k)) T(std::move(data_[j-1]));
+                data_[j-1].~T();
+            }
+        }
+    }
+    // обратно к openGap: хвост возвращается на место i
+    void closeGap(size_t i,size_t k){
+        if constexpr (kTrivial) {
+            std::memmove(static_cast<void*>(data_+i), data_+i+k, (size_-i)*sizeof(T));
+        } else {
+            for(size_t j=i;j<size_;++j){
+                ::new (static_cast<void*>(data_+j)) T(std::move(data_[j+k]));
+                data_[j+k].~T();
+            }
+        }
+    }
+    template<typename... A>
+    static void construct(T* p,A&&... a){ ::new (static_cast<void*>(p)) T(std::forward<A>(a)...); }
+
 public:
     /* --- ctors --- */
     DynamicArray() = default;
-    explicit DynamicArray(size_t n)
-        : size_(n), capacity_(n), data_(std::make_unique<T[]>(n)) {}
-
-    DynamicArray(const T* src,size_t n) : DynamicArray(n) {
-        std::copy(src, src+n, data_.get());
+    explicit DynamicArray(size_t n) : capacity_(n), data_(allocate(n)) {
+        Max(K::PeakCapacity, n);
+        std::uninitialized_value_construct(data_, data_+n);
+        size_ = n;
     }
 
-    DynamicArray(const DynamicArray& o) : DynamicArray(o.size_) {
-        std::copy(o.data_.get(), o.data_.get()+size_, data_.get());
+    DynamicArray(const T* src,size_t n) : capacity_(n), data_(allocate(n)) {
+        Max(K::PeakCapacity, n);
+        try { std::uninitialized_copy(src, src+n, data_); }
+        catch (...) { deallocate(data_, capacity_); throw; }
+        size_ = n;
     }
 
+    DynamicArray(const DynamicArray& o) : DynamicArray(o.data_, o.size_) {}
+
     DynamicArray& operator=(DynamicArray rhs){ swap(rhs); return *this; }
 
-    DynamicArray(DynamicArray&&) noexcept = default;
-    DynamicArray& operator=(DynamicArray&&) noexcept = default;
+    DynamicArray(DynamicArray&& o) noexcept { swap(o); }
+
+    ~DynamicArray(){
+        std::destroy(data_, data_+size_);
+        release();
+    }
+
+    /* --- файловое хранилище --- */
+    static DynamicArray Mapped(const std::string& path, mapped::Mode mode = mapped::Mode::Open, size_t capacity = 0){
+        static_assert(kTrivial, "DynamicArray::Mapped: T must be trivially copyable");
+        static_assert(alignof(T) <= mapped::File::kHeader, "DynamicArray::Mapped: alignment above 64");
+        DynamicArray a;
+        a.file_ = std::make_unique<mapped::File>(path, mode, sizeof(T), alignof(T), capacity);
+        a.data_ = static_cast<T*>(a.file_->Elements());
+        a.capacity_ = a.file_->Capacity(sizeof(T));
+        a.size_ = a.file_->StoredSize();
+        a.Max(K::PeakCapacity, a.capacity_);
+        return a;
+    }
+    bool IsMapped() const { return file_ != nullptr; }
+    /* подсказка ядру для элементов [from, from+count) ∩ [0, size); весь массив —
+       всё отображение вместе с запасом под рост. На куче — ничего */
+    void Advise(mapped::Advice a, size_t from = 0, size_t count = size_t(-1)) const {
+        if(!file_ || from>=size_) return;
+        size_t k = std::min(count, size_-from);
+        file_->Advise(a, from*sizeof(T), from==0 && k==size_ ? capacity_*sizeof(T) : k*sizeof(T));
+    }
+    /* длина в заголовок и сброс страниц на диск; после возврата (async = false)
+       файл переживает падение процесса и ОС в этом состоянии */
+    void Checkpoint(bool async = false) const {
+        if(file_) file_->Sync(size_, async);
+    }
 
     /* --- access --- */
-    size_t GetSize() const { return size_; }
+    using stats::Counters<K>::Stats;
+    size_t GetSize()     const { return size_; }
+    size_t GetCapacity() const { return capacity_; }
 
-    T&       operator[](size_t i){ check(i); return data_[i]; }
-    const T& operator[](size_t i) const { check(i); return data_[i]; }
+    T&       operator[](size_t i){ Bounds::Check(i, size_); return data_[i]; }
+    const T& operator[](size_t i) const { Bounds::Check(i, size_); return data_[i]; }
+    T&       GetUnchecked(size_t i)       { return data_[i]; }
+    const T& GetUnchecked(size_t i) const { return data_[i]; }
+    T*       data()       { return data_; }
+    const T* data() const { return data_; }
 
     /* --- iterators --- */
-    T*       begin()       { return data_.get(); }
-    T*       end()         { return data_.get()+size_; }
-    const T* begin() const { return data_.get(); }
-    const T* end()   const { return data_.get()+size_; }
+    T*       begin()       { return data_; }
+    T*       end()         { return data_+size_; }
+    const T* begin() const { return data_; }
+    const T* end()   const { return data_+size_; }
+
+    /* --- блочный обход: весь массив — один кусок --- */
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const {
+        if(c.pos>=size_) return false;
+        if(file_ && c.pos==0) file_->AdviseScan();     // обход с начала — файл читается подряд
+        p = data_+c.pos; n = size_-c.pos; c.pos = size_;
+        return true;
+    }
 
     /* --- capacity helpers --- */
     void Reserve(size_t newCap){
         if(newCap<=capacity_) return;
-        auto tmp = std::make_unique<T[]>(newCap);
-        std::move(data_.get(), data_.get()+size_, tmp.get());
-        data_.swap(tmp); capacity_ = newCap;
+        if(growMapped(newCap)){ Add(K::Reserves); return; }
+        noteRealloc(K::Reserves, newCap);
+        T* tmp = allocate(newCap);
+        relocate(data_, size_, tmp);
+        release();
+        data_ = tmp; capacity_ = newCap;
+    }
+
+    /* --- запись в сырой запас: вызывающий сам конструирует k элементов в
+       [data()+GetSize(), ...) после Reserve и объявляет их живыми --- */
+    void CommitBack(size_t k){
+        if(k > capacity_-size_) throw std::length_error("CommitBack: k="+std::to_string(k)+" exceeds reserve");
+        size_ += k;
     }
 
     /* --- resize / push --- */
     void Resize(size_t n){
-        Reserve(n);
-        if(n > size_) std::fill(data_.get()+size_, data_.get()+n, T{});
+        if(n > size_){
+            Reserve(n);
+            std::uninitialized_value_construct(data_+size_, data_+n);
+        } else {
+            std::destroy(data_+n, data_+size_);
+        }
         size_ = n;
     }
-    void PushBack(const T& v){
-        if(size_==capacity_) Reserve(capacity_?capacity_*2:1);
-        data_[size_++] = v;
+    void PushBack(const T& v){ EmplaceBack(v); }
+    void PushBack(T&& v)     { EmplaceBack(std::move(v)); }
+
+    /* --- emplace: элемент строится на месте из аргументов --- */
+    template<typename... A>
+    T& EmplaceBack(A&&... a){
+        if(size_==capacity_){
+            // аргументы могут ссылаться внутрь data_ — строим в новом буфере до переезда
+            size_t cap = Growth::Next(capacity_);
+            if constexpr (kTrivial) {
+                if(file_ && file_->Writable()){
+                    // элемент строится до mremap: аргументы могут указывать в старое отображение
+                    alignas(T) unsigned char v[sizeof(T)];
+                    construct(reinterpret_cast<T*>(v), std::forward<A>(a)...);
+                    growMapped(cap);
+                    Add(K::Regrowths);
+                    std::memcpy(static_cast<void*>(data_+size_), v, sizeof(T));
+                    return data_[size_++];
+                }
+            }
+            T* tmp = allocate(cap);
+            try { construct(tmp+size_, std::forward<A>(a)...); }
+            catch (...) { deallocate(tmp, cap); throw; }
+            noteRealloc(K::Regrowths, cap);
+            relocate(data_, size_, tmp);
+            release();
+            data_ = tmp; capacity_ = cap;
+        } else {
+            construct(data_+size_, std::forward<A>(a)...);
+        }
+        return data_[size_++];
+    }
+    // вставка в позицию i: в конец, затем поворот хвоста (для тривиальных T — memmove)
+    template<typename... A>
+    T& Emplace(size_t i,A&&... a){
+        if(i>size_) throw std::out_of_range("Emplace: idx="+std::to_string(i));
+        EmplaceBack(std::forward<A>(a)...);
+        Add(K::BytesMoved, (size_-1-i)*sizeof(T));
+        std::rotate(data_+i, data_+size_-1, data_+size_);
+        return data_[i];
+    }
+
+    /* --- диапазоны: рост сразу под итоговый размер, хвост сдвигается одним memmove,
+       новые элементы копируются пачкой (std::move_iterator — переносятся) --- */
+    template<typename It>
+    void InsertRange(size_t i,It first,It last){
+        if(i>size_) throw std::out_of_range("InsertRange: idx="+std::to_string(i));
+        size_t k = static_cast<size_t>(std::distance(first, last));
+        if(!k) return;
+        if constexpr (std::is_pointer_v<It>) {
+            // источник лежит в сдвигаемом хвосте — вставляем его копию
+            std::less<const T*> lt;
+            if(size_+k <= capacity_ && lt(first, data_+size_) && lt(data_+i, last)){
+                DynamicArray tmp(first, k);
+                InsertRange(i, tmp.begin(), tmp.end());
+                return;
+            }
+        }
+        if(size_+k > capacity_){
+            size_t cap = std::max(size_+k, Growth::Next(capacity_));
+            if(file_ && file_->Writable()){
+                // источник может лежать в старом отображении — сначала его копия
+                DynamicArray src;
+                src.AppendRange(first, last);
+                growMapped(cap);
+                Add(K::Regrowths);
+                InsertRange(i, src.begin(), src.end());
+                return;
+            }
+            T* tmp = allocate(cap);
+            try { std::uninitialized_copy_n(first, k, tmp+i); }         // до переезда: источник может быть внутри data_
+            catch (...) { deallocate(tmp, cap); throw; }
+            noteRealloc(K::Regrowths, cap);
+            relocate(data_, i, tmp);
+            relocate(data_+i, size_-i, tmp+i+k);
+            release();
+            data_ = tmp; capacity_ = cap;
+        } else {
+            openGap(i, k);
+            try { std::uninitialized_copy_n(first, k, data_+i); }
+            catch (...) { closeGap(i, k); throw; }
+        }
+        size_ += k;
+    }
+    template<typename It> void AppendRange(It first,It last) { InsertRange(size_, first, last); }
+    template<typename It> void PrependRange(It first,It last){ InsertRange(0, first, last); }
+
+    /* --- removal (элемент отдаётся move-ом) --- */
+    T PopBack(){
+        if(!size_) throw std::out_of_range("PopBack: empty array");
+        T v = std::move(data_[size_-1]);
+        data_[--size_].~T();
+        return v;
+    }
+    T RemoveAt(size_t i){
+        check(i);
+        T v = std::move(data_[i]);
+        shiftLeft(i+1, i);
+        return v;
+    }
+    void Erase(size_t l,size_t r){          // [l, r], как GetSubsequence
+        if(l>r || r>=size_) throw std::out_of_range("Erase: bad range");
+        shiftLeft(r+1, l);
     }
 
     /* --- util --- */
     void swap(DynamicArray& o) noexcept {
         std::swap(size_, o.size_);
         std::swap(capacity_, o.capacity_);
-        data_.swap(o.data_);
+        std::swap(data_, o.data_);
+        file_.swap(o.file_);
     }
 };
@@ -1,71 +1,89 @@
 #pragma once
 #include "Sequence.hpp"
 #include "DynamicArray.hpp"
+#include "SequenceSlice.hpp"
+#include "Stats.hpp"
+#include <iterator>
 #include <stdexcept>
 #include <string>
 
-template<typename T>
-class ImmutableArraySequence : public Sequence<T> {
-    DynamicArray<T> data_;
+/* Bounds — проверка индекса в Get (BoundsCheck.hpp); с -DSEQ_STATS Stats()
+   считает копии буфера immutable-операциями */
+template<typename T, typename Bounds = CheckedBounds>
+class ImmutableArraySequence : public Sequence<T>, protected stats::Counters<stats::SequenceKind> {
+    SharedArray<T> data_;                       // Clone и GetSubsequence делят буфер
 public:
     ImmutableArraySequence() = default;
     ImmutableArraySequence(const T* p,size_t n): data_(p,n) {}
+    explicit ImmutableArraySequence(DynamicArray<T>&& d): data_(std::move(d)) {}
 
     /* read */
-    size_t GetLength()               const override { return data_.GetSize(); }
-    const T& Get(size_t i)           const override { return data_[i]; }
-    T GetFirst()                     const override {
+    using stats::Counters<stats::SequenceKind>::Stats;
+    size_t GetLength()               const override { return data_.Read().GetSize(); }
+    const T& Get(size_t i)           const override { Bounds::Check(i, GetLength()); return data_.Read().GetUnchecked(i); }
+    const T& GetUnchecked(size_t i)  const          { return data_.Read().GetUnchecked(i); }
+    const T* data()                  const          { return data_.Read().data(); }
+    const T& GetFirst()              const override {
         if (!GetLength()) throw std::out_of_range("empty");
         return Get(0);
     }
-    T GetLast()                      const override {
+    const T& GetLast()               const override {
         if (!GetLength()) throw std::out_of_range("empty");
         return Get(GetLength()-1);
     }
 
-    /* immutable ops (реально меняют копию) */
-    SeqUPtr<T> Append (const T& v) const override {
-        auto cp = std::make_unique<ImmutableArraySequence>(*this);
-        cp->data_.PushBack(v);
-        return cp;
-    }
-    SeqUPtr<T> Prepend(const T& v) const override {
-        auto cp = std::make_unique<ImmutableArraySequence>(*this);
-        cp->data_.Resize(GetLength()+1);
-        for (size_t i=GetLength(); i>0; --i) cp->data_[i]=std::move(cp->data_[i-1]);
-        cp->data_[0]=v;
-        return cp;
-    }
+    /* immutable ops: новый буфер сразу на итоговый размер, [0, i) + вставка + [i, n) пачками */
+    SeqUPtr<T> Append (const T& v) const override { return InsertRange(GetLength(), &v, &v+1); }
+    SeqUPtr<T> Prepend(const T& v) const override { return InsertRange(0, &v, &v+1); }
     SeqUPtr<T> InsertAt(const T& v,size_t i) const override {
         if (i>GetLength()) throw std::out_of_range("InsertAt: bad idx");
-        auto cp = std::make_unique<ImmutableArraySequence>(*this);
-        cp->data_.Resize(GetLength()+1);
-        for (size_t k=GetLength(); k>i; --k) cp->data_[k]=std::move(cp->data_[k-1]);
-        cp->data_[i]=v;
-        return cp;
+        return InsertRange(i, &v, &v+1);
     }
     SeqUPtr<T> Concat(const Sequence<T>* o) const override {
-        auto cp = std::make_unique<ImmutableArraySequence>(*this);
-        for (size_t i=0;i<o->GetLength();++i) cp->data_.PushBack(o->Get(i));
-        return cp;
+        stats::CountCopy<T>(*this, GetLength());
+        DynamicArray<T> d;
+        d.Reserve(GetLength()+o->GetLength());
+        d.AppendRange(data_.Read().begin(), data_.Read().end());
+        o->ForEachChunk([&d](const T* p, size_t n) { d.AppendRange(p, p+n); return true; });
+        return SeqUPtr<T>(new ImmutableArraySequence(std::move(d)));
     }
+    template<typename It>
+    SeqUPtr<T> InsertRange(size_t i,It first,It last) const {
+        if (i>GetLength()) throw std::out_of_range("InsertRange: bad idx");
+        stats::CountCopy<T>(*this, GetLength());
+        const T* b = data_.Read().begin();
+        DynamicArray<T> d;
+        d.Reserve(GetLength()+static_cast<size_t>(std::distance(first, last)));
+        d.AppendRange(b, b+i);
+        d.AppendRange(first, last);
+        d.AppendRange(b+i, b+GetLength());
+        return SeqUPtr<T>(new ImmutableArraySequence(std::move(d)));
+    }
+    template<typename It> SeqUPtr<T> AppendRange(It first,It last)  const { return InsertRange(GetLength(), first, last); }
+    template<typename It> SeqUPtr<T> PrependRange(It first,It last) const { return InsertRange(0, first, last); }
 
     /* mutable ops — запрещены */
     void Append (const T&) override { throw std::logic_error("immutable"); }
     void Prepend(const T&) override { throw std::logic_error("immutable"); }
     void InsertAt(const T&,size_t) override { throw std::logic_error("immutable"); }
     Sequence<T>* Concat(Sequence<T>*) override { throw std::logic_error("immutable"); }
+    T PopBack()  override { throw std::logic_error("immutable"); }
+    T PopFront() override { throw std::logic_error("immutable"); }
+    T RemoveAt(size_t) override { throw std::logic_error("immutable"); }
+    void EraseRange(size_t,size_t) override { throw std::logic_error("immutable"); }
 
     /* service */
     SeqUPtr<T> GetSubsequence(size_t l,size_t r) const override {
         if (l>r || r>=GetLength()) throw std::out_of_range("subseq: bad range");
-        auto res = std::make_unique<ImmutableArraySequence>();
-        for (size_t i=l;i<=r;++i) res->data_.PushBack(data_[i]);
-        return res;
+        return SeqUPtr<T>(new SequenceSlice<T>(data_, l, r-l+1, true));   // срез без копирования
     }
     SeqUPtr<T> Clone() const override { return std::make_unique<ImmutableArraySequence>(*this); }
     Sequence<T>* Instance() override  { return Clone().release(); }
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const override {
+        return data_.Read().NextChunk(c,p,n);
+    }
+    const SharedArray<T>& Buffer() const { return data_; }
 
-    auto begin() const { return data_.begin(); }
-    auto end()   const { return data_.end();   }
+    auto begin() const { return data_.Read().begin(); }
+    auto end()   const { return data_.Read().end();   }
 };
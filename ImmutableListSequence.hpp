@@ -1,38 +1,55 @@
 #pragma once
 #include "Sequence.hpp"
 #include "LinkedList.hpp"
+#include "PersistentList.hpp"
+#include "Stats.hpp"
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 
-template<typename T>
-class ImmutableListSequence : public Sequence<T> {
-    LinkedList<T> list_;
+/* List — хранилище. По умолчанию PersistentList<T>: копия версии — O(1),
+   Prepend и GetSubsequence делят узлы с исходной версией, Append/Concat
+   дописывают за общим хвостом или копируют только префикс.
+   Подходят и LinkedList<T>, LinkedList<T, NodePool> и т.п. (копия — O(n));
+   с -DSEQ_STATS Stats() считает эти полные копии */
+template<typename T, typename List = PersistentList<T>>
+class ImmutableListSequence : public Sequence<T>, protected stats::Counters<stats::SequenceKind> {
+    List list_;
+
+    static constexpr bool kCopyOnWrite = !std::is_same_v<List, PersistentList<T>>;
+    void countCopy(size_t n) const { if constexpr (kCopyOnWrite) stats::CountCopy<T>(*this, n); }
 public:
     ImmutableListSequence() = default;
     ImmutableListSequence(const T* p,size_t n): list_(p,n) {}
-    ImmutableListSequence(const LinkedList<T>& lst): list_(lst) {}
+    ImmutableListSequence(const List& lst): list_(lst) {}
+    ImmutableListSequence(List&& lst): list_(std::move(lst)) {}
     /* read */
+    using stats::Counters<stats::SequenceKind>::Stats;
     size_t GetLength()               const override { return list_.GetLength(); }
     const T& Get(size_t i)           const override { return list_.Get(i); }
-    T GetFirst()                     const override { return list_.GetFirst(); }
-    T GetLast()                      const override { return list_.GetLast();  }
+    const T& GetFirst()              const override { return list_.GetFirst(); }
+    const T& GetLast()               const override { return list_.GetLast();  }
 
     /* immutable ops */
     SeqUPtr<T> Append (const T& v) const override {
+        countCopy(GetLength());
         auto cp = std::make_unique<ImmutableListSequence>(*this);
         cp->list_.Append(v); return cp;
     }
     SeqUPtr<T> Prepend(const T& v) const override {
+        countCopy(GetLength());
         auto cp = std::make_unique<ImmutableListSequence>(*this);
         cp->list_.Prepend(v); return cp;
     }
     SeqUPtr<T> InsertAt(const T& v,size_t i) const override {
+        countCopy(GetLength());
         auto cp = std::make_unique<ImmutableListSequence>(*this);
         cp->list_.InsertAt(v,i); return cp;
     }
     SeqUPtr<T> Concat(const Sequence<T>* o) const override {
+        countCopy(GetLength());
         auto cp = std::make_unique<ImmutableListSequence>(*this);
-        for (size_t i=0;i<o->GetLength();++i) cp->list_.Append(o->Get(i));
+        o->ForEach([&](const T& v) { cp->list_.Append(v); });
         return cp;
     }
 
@@ -41,14 +58,22 @@ public:
     void Prepend(const T&) override { throw std::logic_error("immutable"); }
     void InsertAt(const T&,size_t) override { throw std::logic_error("immutable"); }
     Sequence<T>* Concat(Sequence<T>*) override { throw std::logic_error("immutable"); }
+    T PopBack()  override { throw std::logic_error("immutable"); }
+    T PopFront() override { throw std::logic_error("immutable"); }
+    T RemoveAt(size_t) override { throw std::logic_error("immutable"); }
+    void EraseRange(size_t,size_t) override { throw std::logic_error("immutable"); }
 
     /* service */
     SeqUPtr<T> GetSubsequence(size_t l,size_t r) const override {
         if (l>r || r>=GetLength()) throw std::out_of_range("subseq: bad range");
-        return SeqUPtr<T>( new ImmutableListSequence(*list_.GetSubList(l,r)) );
+        countCopy(r-l+1);
+        return SeqUPtr<T>( new ImmutableListSequence(std::move(*std::unique_ptr<List>(list_.GetSubList(l,r)))) );
     }
     SeqUPtr<T> Clone() const override { return std::make_unique<ImmutableListSequence>(*this); }
     Sequence<T>* Instance() override { return Clone().release(); }
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const override {
+        return list_.NextChunk(c,p,n);
+    }
 
     auto begin() const { return list_.begin(); }
     auto end()   const { return list_.end();   }
@@ -0,0 +1,127 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+
+/* Адресуемая d-арная куча. Push возвращает Handle, по которому элемент можно
+   изменить (Update/DecreaseKey) или удалить (Erase) за O(log_d n).
+   Порядок — как у PriorityQueue: на вершине «наибольший» по Compare.
+   Handle остаётся валидным, пока элемент в куче. После Pop/Erase номер
+   может достаться новому элементу, но поколение у него уже другое: старый
+   Handle не Contains, а Get/Update/DecreaseKey/Erase по нему бросают. */
+template<class T, class Compare = std::less<T>, size_t Arity = 4>
+class IndexedPriorityQueue {
+    static_assert(Arity >= 2, "IndexedPriorityQueue: Arity must be >= 2");
+public:
+    struct Handle { size_t id; size_t gen; };     // Handle{} не валиден никогда
+
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    struct Entry { T value; size_t id; };
+
+    std::vector<Entry>  heap;
+    std::vector<size_t> pos;        // id -> индекс в heap (npos — свободен)
+    std::vector<size_t> gen;        // id -> поколение, растёт при освобождении номера
+    std::vector<size_t> freeIds;
+    Compare cmp;
+
+    // a должен стоять выше b
+    bool above(const T& a, const T& b) const { return cmp(b, a); }
+
+    void place(size_t i, Entry&& e) { pos[e.id] = i; heap[i] = std::move(e); }
+
+    void siftUp(size_t i) {
+        Entry e = std::move(heap[i]);
+        while (i > 0) {
+            size_t parent = (i - 1) / Arity;
+            if (!above(e.value, heap[parent].value)) break;
+            place(i, std::move(heap[parent]));
+            i = parent;
+        }
+        place(i, std::move(e));
+    }
+    void siftDown(size_t i) {
+        Entry e = std::move(heap[i]);
+        size_t n = heap.size();
+        for (;;) {
+            size_t first = i * Arity + 1;
+            if (first >= n) break;
+            size_t last = std::min(first + Arity, n), best = first;
+            for (size_t c = first + 1; c < last; ++c)
+                if (above(heap[c].value, heap[best].value)) best = c;
+            if (!above(heap[best].value, e.value)) break;
+            place(i, std::move(heap[best]));
+            i = best;
+        }
+        place(i, std::move(e));
+    }
+    size_t index(Handle h) const {
+        if (!Contains(h)) throw std::out_of_range("IndexedPriorityQueue: stale handle");
+        return pos[h.id];
+    }
+    // вынуть элемент с индексом i, заткнув дыру последним
+    T removeAt(size_t i) {
+        T item = std::move(heap[i].value);
+        size_t id = heap[i].id;
+        pos[id] = npos; ++gen[id]; freeIds.push_back(id);
+        Entry last = std::move(heap.back()); heap.pop_back();
+        if (i < heap.size()) {
+            size_t lastId = last.id;
+            place(i, std::move(last));
+            siftUp(i);
+            siftDown(pos[lastId]);
+        }
+        return item;
+    }
+
+public:
+    IndexedPriorityQueue() = default;
+    explicit IndexedPriorityQueue(Compare c) : cmp(c) {}
+
+    Handle Push(const T& item) {
+        size_t id;
+        if (freeIds.empty()) { id = pos.size(); pos.push_back(npos); gen.push_back(1); }
+        else { id = freeIds.back(); freeIds.pop_back(); }
+        heap.push_back(Entry{item, id});
+        pos[id] = heap.size() - 1;
+        siftUp(heap.size() - 1);
+        return Handle{id, gen[id]};
+    }
+    const T& Top() const {
+        assert(!heap.empty());
+        return heap.front().value;
+    }
+    T Pop() {
+        assert(!heap.empty());
+        return removeAt(0);
+    }
+
+    bool     Contains(Handle h) const { return h.id < pos.size() && pos[h.id] != npos && gen[h.id] == h.gen; }
+    const T& Get(Handle h)      const { return heap[index(h)].value; }
+
+    // произвольное изменение приоритета
+    void Update(Handle h, const T& item) {
+        size_t i = index(h);
+        heap[i].value = item;
+        siftUp(i);
+        siftDown(pos[h.id]);
+    }
+    // элемент может только подняться к вершине (для min-кучи на std::greater —
+    // классическое уменьшение ключа в Дейкстре)
+    void DecreaseKey(Handle h, const T& item) {
+        size_t i = index(h);
+        if (above(heap[i].value, item))
+            throw std::invalid_argument("DecreaseKey: new priority is lower");
+        heap[i].value = item;
+        siftUp(i);
+    }
+    T Erase(Handle h) { return removeAt(index(h)); }
+
+    size_t Size() const { return heap.size(); }
+    void Print() const {
+        for (const auto& e : heap) std::cout << e.value << ' ';
+        std::cout << std::endl;
+    }
+};
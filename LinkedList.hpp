@@ -1,36 +1,55 @@
 #pragma once
+#include "BoundsCheck.hpp"
+#include "ChunkCursor.hpp"
+#include "NodePool.hpp"
+#include "Stats.hpp"
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
 
-template<typename T>
-class LinkedList {
-    struct Node { T val; Node* next; explicit Node(const T& v): val(v), next(nullptr){} };
+/* NodeAlloc — политика выделения узлов (NodePool.hpp): HeapNodeAlloc или NodePool;
+   Bounds — проверка индекса в Get (BoundsCheck.hpp). С -DSEQ_STATS Stats()
+   считает выделенные и освобождённые узлы и переходы по next при поиске
+   позиции в Get / InsertAt / RemoveAt / Erase (Stats.hpp) */
+template<typename T, template<class> class NodeAlloc = HeapNodeAlloc, typename Bounds = CheckedBounds>
+class LinkedList : protected stats::Counters<stats::ListKind> {
+    using K = stats::ListKind;
 
+    struct Node {
+        T val; Node* next;
+        template<typename... A> explicit Node(std::in_place_t, A&&... a): val(std::forward<A>(a)...), next(nullptr){}
+    };
+
+    NodeAlloc<Node> alloc_;
     Node* head_ = nullptr;
     Node* tail_ = nullptr;
     size_t len_ = 0;
 
-    void range_check(size_t i) const {
-        if (i >= len_)
-            throw std::out_of_range("IndexOutOfRange: index=" + std::to_string(i) +
-                                    " length=" + std::to_string(len_));
+    void range_check(size_t i) const { if (i >= len_) detail::ThrowIndexOutOfRange(i, len_, "length"); }
+    const Node* nodeAt(size_t idx) const {
+        Add(K::PointerHops, idx);
+        const Node* p = head_; while(idx--) p = p->next; return p;
     }
+    template<typename... A>
+    Node* newNode(A&&... a){ Node* n = alloc_.New(std::forward<A>(a)...); Add(K::NodesAllocated); return n; }
+    void deleteNode(Node* n){ alloc_.Delete(n); Add(K::NodesFreed); }
 
 public:
     /* --- ctors/dtor --- */
     LinkedList() = default;
     LinkedList(const T* src,size_t n){ for(size_t i=0;i<n;++i) Append(src[i]); }
 
-    LinkedList(const LinkedList& o){ for(const auto& v:o) Append(v); }
+    LinkedList(const LinkedList& o): stats::Counters<K>(){ for(const auto& v:o) Append(v); }
     LinkedList& operator=(LinkedList rhs){ swap(rhs); return *this; }
 
-    LinkedList(LinkedList&&) noexcept = default;
+    LinkedList(LinkedList&& o) noexcept { swap(o); }
     LinkedList& operator=(LinkedList&&) noexcept = default;
 
     ~LinkedList(){ clear(); }
 
     /* --- read --- */
+    using stats::Counters<K>::Stats;
     size_t   GetLength() const { return len_; }
     const T& GetFirst()  const {
         if(!head_) throw std::out_of_range("GetFirst: empty list");
@@ -40,38 +59,115 @@ public:
         if(!tail_) throw std::out_of_range("GetLast: empty list");
         return tail_->val;
     }
-    const T& Get(size_t idx) const {
-        range_check(idx);
-        Node* p = head_; while(idx--) p = p->next;
-        return p->val;
+    const T& Get(size_t idx) const { Bounds::Check(idx, len_, "length"); return nodeAt(idx)->val; }
+    const T& GetUnchecked(size_t idx) const { return nodeAt(idx)->val; }
+
+    /* --- блочный обход: по узлу за раз, c.node — следующий узел --- */
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const {
+        const Node* node = c.pos ? static_cast<const Node*>(c.node) : head_;
+        if(!node) return false;
+        p = &node->val; n = 1;
+        c.node = node->next; ++c.pos;
+        return true;
     }
 
-    /* --- modify --- */
-    void Append(const T& v){
-        Node* n = new Node(v);
+    /* --- modify: значение строится прямо в узле --- */
+    template<typename... A>
+    T& EmplaceBack(A&&... a){
+        Node* n = newNode(std::in_place, std::forward<A>(a)...);
         if(!head_) head_ = tail_ = n;
         else tail_ = tail_->next = n;
         ++len_;
+        return n->val;
     }
-    void Prepend(const T& v){
-        Node* n = new Node(v);
+    template<typename... A>
+    T& EmplaceFront(A&&... a){
+        Node* n = newNode(std::in_place, std::forward<A>(a)...);
         n->next = head_; head_ = n;
         if(!tail_) tail_ = head_;
         ++len_;
+        return n->val;
     }
-    void InsertAt(const T& v,size_t i){
+    template<typename... A>
+    T& Emplace(size_t i,A&&... a){
         if(i>len_) throw std::out_of_range("InsertAt: idx="+std::to_string(i));
-        if(i==0){ Prepend(v); return; }
-        if(i==len_){ Append(v); return; }
+        if(i==0) return EmplaceFront(std::forward<A>(a)...);
+        if(i==len_) return EmplaceBack(std::forward<A>(a)...);
         Node* prev=head_;
+        Add(K::PointerHops, i-1);
         for(size_t k=1;k<i;++k) prev=prev->next;
-        Node* cur=new Node(v); cur->next=prev->next; prev->next=cur; ++len_;
+        Node* cur=newNode(std::in_place, std::forward<A>(a)...);
+        cur->next=prev->next; prev->next=cur; ++len_;
+        return cur->val;
+    }
+    void Append(const T& v){ EmplaceBack(v); }
+    void Append(T&& v)     { EmplaceBack(std::move(v)); }
+    void Prepend(const T& v){ EmplaceFront(v); }
+    void Prepend(T&& v)     { EmplaceFront(std::move(v)); }
+    void InsertAt(const T& v,size_t i){ Emplace(i, v); }
+    void InsertAt(T&& v,size_t i)     { Emplace(i, std::move(v)); }
+
+    /* --- removal --- */
+    T PopFront(){
+        if(!head_) throw std::out_of_range("PopFront: empty list");
+        Node* n = head_; head_ = head_->next;
+        if(!head_) tail_ = nullptr;
+        --len_;
+        T v = std::move(n->val); deleteNode(n);
+        return v;
+    }
+    T PopBack(){
+        if(!tail_) throw std::out_of_range("PopBack: empty list");
+        return RemoveAt(len_-1);
+    }
+    T RemoveAt(size_t i){
+        range_check(i);
+        if(i==0) return PopFront();
+        Node* prev=head_;
+        Add(K::PointerHops, i-1);
+        for(size_t k=1;k<i;++k) prev=prev->next;
+        Node* n=prev->next; prev->next=n->next;
+        if(n==tail_) tail_=prev;
+        --len_;
+        T v = std::move(n->val); deleteNode(n);
+        return v;
+    }
+    void Erase(size_t l,size_t r){          // [l, r]
+        if(l>r||r>=len_) throw std::out_of_range("Erase: bad range");
+        Node* prev=nullptr; Node* cur=head_;
+        Add(K::PointerHops, l);
+        for(size_t k=0;k<l;++k){ prev=cur; cur=cur->next; }
+        for(size_t k=l;k<=r;++k){ Node* n=cur; cur=cur->next; deleteNode(n); }
+        (prev ? prev->next : head_) = cur;
+        if(!cur) tail_=prev;
+        len_ -= r-l+1;
+    }
+
+    /* --- сортировка: восходящий merge sort перецепляет узлы, значения не
+       двигаются; устойчива, O(n log n), без дополнительной памяти. Цепочки
+       сливаются, как разряды двоичного счётчика (bins[k] — 2^k узлов), так что
+       короткие слияния идут по узлам, ещё лежащим в кэше --- */
+    template<typename Cmp>
+    void Sort(Cmp cmp){
+        if(len_<2) return;
+        Chain bins[64] = {};
+        for(Node* rest=head_; rest;){
+            Chain run{ rest, rest };
+            rest = rest->next; run.head->next = nullptr;
+            size_t k = 0;
+            for(; bins[k].head; ++k){ run = merge(bins[k], run, cmp); bins[k] = Chain{}; }
+            bins[k] = run;
+        }
+        Chain res{};
+        for(const Chain& c : bins) if(c.head) res = res.head ? merge(c, res, cmp) : c;   // старшие разряды — раньше
+        head_ = res.head; tail_ = res.tail;
     }
 
     LinkedList* GetSubList(size_t l,size_t r) const{
         if(l>r||r>=len_) throw std::out_of_range("GetSubList: bad range");
         auto* res = new LinkedList;
-        for(size_t i=l;i<=r;++i) res->Append(Get(i));
+        const Node* p = head_; for(size_t k=0;k<l;++k) p = p->next;     // один проход, а не Get(i) на каждый
+        for(size_t i=l;i<=r;++i, p=p->next) res->Append(p->val);
         return res;
     }
     LinkedList* Concat(const LinkedList* o) const{
@@ -102,6 +198,27 @@ public:
     cit begin() const { return cit(head_); }  cit end() const { return cit(nullptr); }
 
 private:
-    void clear(){ while(head_){ Node* n=head_; head_=head_->next; delete n; } tail_=nullptr; len_=0; }
-    void swap(LinkedList& o){ std::swap(head_,o.head_); std::swap(tail_,o.tail_); std::swap(len_,o.len_); }
+    struct Chain { Node* head = nullptr; Node* tail = nullptr; };
+    // слияние двух отсортированных цепочек; при равенстве первым идёт узел из a
+    template<typename Cmp>
+    static Chain merge(Chain a,Chain b,Cmp& cmp){
+        Node* head=nullptr; Node** out=&head;
+        Node* x=a.head; Node* y=b.head;
+        while(x && y){
+            if(cmp(y->val, x->val)){ *out=y; out=&y->next; y=y->next; }
+            else                   { *out=x; out=&x->next; x=x->next; }
+        }
+        *out = x ? x : y;
+        return { head, x ? a.tail : b.tail };
+    }
+    void clear(){
+        // пул с тривиальными T отдаёт слэбы целиком, без обхода узлов
+        if constexpr (NodeAlloc<Node>::kBulkRelease && std::is_trivially_destructible_v<T>) { head_=nullptr; Add(K::NodesFreed, len_); }
+        else while(head_){ Node* n=head_; head_=head_->next; deleteNode(n); }
+        alloc_.Release(); tail_=nullptr; len_=0;
+    }
+    void swap(LinkedList& o){
+        alloc_.swap(o.alloc_);
+        std::swap(head_,o.head_); std::swap(tail_,o.tail_); std::swap(len_,o.len_);
+    }
 };
@@ -0,0 +1,200 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define MAPPED_POSIX 0
+#endif
+
+/* Файл, отображённый в память, — хранилище DynamicArray::Mapped для тривиально
+   копируемых T. Формат: 64-байтовый заголовок (сигнатура, размер элемента,
+   длина на момент последнего Checkpoint), за ним элементы подряд, как в памяти.
+   Открытие не читает данные: длина берётся из заголовка, страницы подгружает
+   ядро при первом обращении — время старта не зависит от размера файла.
+   Рост — ftruncate + mremap: содержимое не копируется, адрес может смениться.
+     Mode::Create   — новый файл (старый затирается);
+     Mode::Open     — существующий на чтение и запись (нет файла — создаётся);
+     Mode::ReadOnly — существующий; страницы MAP_PRIVATE: изменения остаются
+                      в процессе, в файл не попадают.
+   Без POSIX (MAPPED_POSIX == 0) File есть, но открытие бросает runtime_error. */
+
+namespace mapped {
+
+enum class Mode   { Create, Open, ReadOnly };
+enum class Advice { Normal, Sequential, Random, WillNeed, DontNeed };
+
+#if MAPPED_POSIX
+class File {
+    struct Header {
+        char     magic[8];
+        uint32_t elemSize;
+        uint32_t elemAlign;
+        uint64_t size;                  // элементов на момент последнего Checkpoint / закрытия
+        uint64_t reserved[5];
+    };
+    static_assert(sizeof(Header) == 64, "mapped: header must be one cache line");
+    static constexpr char kMagic[8] = { 'S', 'E', 'Q', 'A', 'R', 'R', '0', '1' };
+
+    int         fd_       = -1;
+    char*       base_     = nullptr;    // заголовок, за ним элементы
+    size_t      bytes_    = 0;          // длина отображения = длина файла
+    bool        writable_ = false;
+    std::atomic<Advice> scan_{ Advice::Normal };    // подсказка на весь файл; AdviseScan — из const-обходов
+    std::string path_;
+
+    Header& header() const { return *reinterpret_cast<Header*>(base_); }
+
+    [[noreturn]] void fail(const char* what) const {
+        throw std::system_error(errno, std::generic_category(), std::string("mapped: ") + what + " " + path_);
+    }
+    void map() {
+        int prot  = PROT_READ | PROT_WRITE;     // ReadOnly тоже пишет — в свои копии страниц
+        int flags = writable_ ? MAP_SHARED : MAP_PRIVATE;
+        void* p = ::mmap(nullptr, bytes_, prot, flags, fd_, 0);
+        if (p == MAP_FAILED) fail("mmap");
+        base_ = static_cast<char*>(p);
+    }
+    void close() {
+        if (base_) ::munmap(base_, bytes_);
+        if (fd_ >= 0) ::close(fd_);
+        base_ = nullptr; fd_ = -1;
+    }
+    void validate(size_t elemSize, size_t elemAlign) const {
+        const Header& h = header();
+        if (std::memcmp(h.magic, kMagic, sizeof kMagic) != 0)
+            throw std::runtime_error("mapped: " + path_ + " is not a DynamicArray file");
+        if (h.elemSize != elemSize || h.elemAlign != elemAlign)
+            throw std::runtime_error("mapped: " + path_ + " element size/align " + std::to_string(h.elemSize)
+                                     + "/" + std::to_string(h.elemAlign) + ", expected "
+                                     + std::to_string(elemSize) + "/" + std::to_string(elemAlign));
+        if (h.size > (bytes_ - kHeader) / elemSize)
+            throw std::runtime_error("mapped: " + path_ + " is truncated");
+    }
+
+public:
+    static constexpr size_t kHeader = sizeof(Header);
+
+    File(const std::string& path, Mode mode, size_t elemSize, size_t elemAlign, size_t minCapacity)
+        : writable_(mode != Mode::ReadOnly), path_(path) {
+        int oflags = mode == Mode::Create ? O_RDWR | O_CREAT | O_TRUNC
+                   : mode == Mode::Open   ? O_RDWR | O_CREAT
+                                          : O_RDONLY;
+        fd_ = ::open(path.c_str(), oflags | O_CLOEXEC, 0644);
+        if (fd_ < 0) fail("open");
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) { int e = errno; close(); errno = e; fail("fstat"); }
+        bytes_ = static_cast<size_t>(st.st_size);
+        bool fresh = bytes_ == 0;
+        try {
+            if (fresh) {
+                if (!writable_) throw std::runtime_error("mapped: " + path_ + " is empty");
+                bytes_ = kHeader + minCapacity * elemSize;
+                if (::ftruncate(fd_, static_cast<off_t>(bytes_)) != 0) fail("ftruncate");
+            }
+            if (bytes_ < kHeader) throw std::runtime_error("mapped: " + path_ + " is not a DynamicArray file");
+            map();
+            if (fresh) {
+                Header& h = header();
+                std::memcpy(h.magic, kMagic, sizeof kMagic);
+                h.elemSize = static_cast<uint32_t>(elemSize);
+                h.elemAlign = static_cast<uint32_t>(elemAlign);
+                h.size = 0;
+            }
+            validate(elemSize, elemAlign);
+            if (writable_ && bytes_ < kHeader + minCapacity * elemSize) Grow(kHeader + minCapacity * elemSize);
+        } catch (...) { close(); throw; }
+    }
+    ~File() { close(); }
+    File(const File&)            = delete;
+    File& operator=(const File&) = delete;
+
+    void*    Elements() const                 { return base_ + kHeader; }
+    size_t   Capacity(size_t elemSize) const  { return (bytes_ - kHeader) / elemSize; }
+    uint64_t StoredSize() const               { return header().size; }
+    bool     Writable() const                 { return writable_; }
+    const std::string& Path() const           { return path_; }
+
+    /* файл и отображение — до bytes; Elements() после вызова может смениться */
+    void Grow(size_t bytes) {
+        if (bytes <= bytes_) return;
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) fail("ftruncate");
+#ifdef MREMAP_MAYMOVE
+        void* p = ::mremap(base_, bytes_, bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) fail("mremap");
+        base_ = static_cast<char*>(p);
+        bytes_ = bytes;
+#else
+        char* old = base_; size_t oldBytes = bytes_;
+        bytes_ = bytes;
+        try { map(); }                          // старое отображение ещё живо: при ошибке File цел
+        catch (...) { bytes_ = oldBytes; throw; }
+        ::munmap(old, oldBytes);                // разделяемое отображение: данные уже в файле
+#endif
+    }
+
+    /* подсказка ядру для байтов [off, off+len) области элементов; DontNeed над
+       MAP_PRIVATE выбросил бы изменения процесса — для ReadOnly запрещён */
+    void Advise(Advice a, size_t off, size_t len) {
+        if (a == Advice::DontNeed && !writable_)
+            throw std::invalid_argument("mapped: DontNeed would discard private changes of " + path_);
+        static const long page = ::sysconf(_SC_PAGESIZE);
+        int adv = a == Advice::Sequential ? MADV_SEQUENTIAL
+                : a == Advice::Random     ? MADV_RANDOM
+                : a == Advice::WillNeed   ? MADV_WILLNEED
+                : a == Advice::DontNeed   ? MADV_DONTNEED
+                                          : MADV_NORMAL;
+        size_t from = kHeader + off, to = std::min(bytes_, from + std::min(len, bytes_));
+        size_t start = from - from % static_cast<size_t>(page);
+        if (to > start && ::madvise(base_ + start, to - start, adv) != 0) fail("madvise");
+        if (off == 0 && to == bytes_) scan_ = a;
+    }
+    /* полный проход по элементам: если подсказки не было — Sequential, один раз;
+       параллельные обходы спорят только за scan_, madvise зовёт победитель */
+    void AdviseScan() {
+        Advice expected = Advice::Normal;
+        if (scan_.compare_exchange_strong(expected, Advice::Sequential)) Advise(Advice::Sequential, 0, bytes_);
+    }
+
+    /* длина в заголовок; Sync — ещё и сброс страниц на диск (MS_SYNC ждёт записи) */
+    void SetSize(uint64_t size) { if (writable_) header().size = size; }
+    void Sync(uint64_t size, bool async) {
+        if (!writable_) return;
+        SetSize(size);
+        if (::msync(base_, bytes_, async ? MS_ASYNC : MS_SYNC) != 0) fail("msync");
+    }
+};
+#else
+class File {
+public:
+    static constexpr size_t kHeader = 64;
+
+    File(const std::string& path, Mode, size_t, size_t, size_t) {
+        throw std::runtime_error("mapped: " + path + ": memory-mapped files are not supported on this platform");
+    }
+    void*    Elements() const                 { return nullptr; }
+    size_t   Capacity(size_t) const           { return 0; }
+    uint64_t StoredSize() const               { return 0; }
+    bool     Writable() const                 { return false; }
+    const std::string& Path() const           { static const std::string none; return none; }
+    void Grow(size_t) {}
+    void Advise(Advice, size_t, size_t) {}
+    void AdviseScan() {}
+    void SetSize(uint64_t) {}
+    void Sync(uint64_t, bool) {}
+};
+#endif
+
+} // namespace mapped
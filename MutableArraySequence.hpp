@@ -1,53 +1,102 @@
 #pragma once
 #include "Sequence.hpp"
 #include "DynamicArray.hpp"
+#include "SequenceSlice.hpp"
+#include "Stats.hpp"
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 
-template<typename T>
-class MutableArraySequence : public Sequence<T> {
-    DynamicArray<T> data_;
+/* Хранилище — SharedArray: копия последовательности и срезы GetSubsequence
+   делят буфер за O(1), копирование — только при изменении общего буфера
+   (с -DSEQ_STATS его считает Stats().FullCopies). Буфер над файлом не
+   делится: копия последовательности и срез получают свою копию в куче.
+   Bounds — проверка индекса в Get (BoundsCheck.hpp, по умолчанию CheckedBounds) */
+template<typename T, typename Bounds>
+class MutableArraySequence : public Sequence<T>, protected stats::Counters<stats::SequenceKind> {
+    SharedArray<T> data_;
+
+    DynamicArray<T>& write() {
+        if (data_.IsShared()) stats::CountCopy<T>(*this, GetLength());
+        return data_.Write();
+    }
+
+    template<typename... A>
+    void emplaceAt(size_t idx,A&&... a) {
+        if (idx>GetLength()) throw std::out_of_range("InsertAt: bad idx");
+        write().Emplace(idx, std::forward<A>(a)...);
+    }
 public:
     /* ctors */
     MutableArraySequence() = default;
     MutableArraySequence(const T* p,size_t n): data_(p,n) {}
-    MutableArraySequence(const MutableArraySequence&)            = default;
-    MutableArraySequence& operator=(const MutableArraySequence&) = default;
+    explicit MutableArraySequence(DynamicArray<T>&& d): data_(std::move(d)) {}
+    MutableArraySequence(const MutableArraySequence& o): stats::Counters<stats::SequenceKind>(), data_(o.data_.ForOwner()) {}
+    MutableArraySequence& operator=(const MutableArraySequence& o) { data_ = o.data_.ForOwner(); return *this; }
     MutableArraySequence(MutableArraySequence&&) noexcept        = default;
     MutableArraySequence& operator=(MutableArraySequence&&) noexcept = default;
 
     /* read */
-    size_t GetLength()               const override { return data_.GetSize(); }
-    const T& Get(size_t i)           const override { return data_[i]; }
-    T GetFirst()                     const override {
+    using stats::Counters<stats::SequenceKind>::Stats;
+    size_t GetLength()               const override { return data_.Read().GetSize(); }
+    const T& Get(size_t i)           const override { Bounds::Check(i, GetLength()); return data_.Read().GetUnchecked(i); }
+    const T& GetUnchecked(size_t i)  const          { return data_.Read().GetUnchecked(i); }
+    const T* data()                  const          { return data_.Read().data(); }
+    T*       data()                                 { return write().data(); }   // свой буфер: общий копируется
+    const T& GetFirst()              const override {
         if (!GetLength()) throw std::out_of_range("empty");
         return Get(0);
     }
-    T GetLast()                      const override {
+    const T& GetLast()               const override {
         if (!GetLength()) throw std::out_of_range("empty");
         return Get(GetLength()-1);
     }
 
     /* mutable */
-    void Append (const T& v) override { data_.PushBack(v); }
-    void Prepend(const T& v) override {
-        data_.Reserve(GetLength()+1);
-        data_.Resize(GetLength()+1);
-        for (size_t i=GetLength()-1;i>0;--i) data_[i]=std::move(data_[i-1]);
-        data_[0]=v;
-    }
+    // v может лежать в общем буфере: Write() его не освобождает, пока есть другие владельцы.
+    // Копирующие перегрузки — через detail::CopyingPath (для move-only T бросают)
+    void Append (const T& v) override { detail::CopyingPath<T>(v, [this](const auto& x) { write().EmplaceBack(x); }); }
+    void Append (T&& v)      override { write().EmplaceBack(std::move(v)); }
+    void Prepend(const T& v) override { InsertAt(v, 0); }
+    void Prepend(T&& v)      override { InsertAt(std::move(v), 0); }
     void InsertAt(const T& v,size_t idx) override {
-        if (idx>GetLength()) throw std::out_of_range("InsertAt: bad idx");
-        data_.Reserve(GetLength()+1);
-        data_.Resize(GetLength()+1);
-        for (size_t i=GetLength()-1;i>idx;--i) data_[i]=std::move(data_[i-1]);
-        data_[idx]=v;
+        detail::CopyingPath<T>(v, [this, idx](const auto& x) { emplaceAt(idx, x); });
     }
+    void InsertAt(T&& v,size_t idx)      override { emplaceAt(idx, std::move(v)); }
+
+    /* на конкретном типе — сразу в буфер, без промежуточного T */
+    template<typename... A> void EmplaceBack (A&&... a)        { write().EmplaceBack(std::forward<A>(a)...); }
+    template<typename... A> void EmplaceFront(A&&... a)        { emplaceAt(0, std::forward<A>(a)...); }
+    template<typename... A> void EmplaceAt(size_t i, A&&... a) { emplaceAt(i, std::forward<A>(a)...); }
     Sequence<T>* Concat(Sequence<T>* other) override {
-        for (size_t i=0;i<other->GetLength();++i) Append(other->Get(i));
+        detail::CopyingPath<T>(other, [this](auto* o) {
+            size_t left = o->GetLength();           // other может оказаться нами самими
+            auto& d = write();
+            d.Reserve(d.GetSize()+left);
+            o->ForEachChunk([&](const T* p, size_t n) {
+                n = std::min(n, left); left -= n;
+                d.AppendRange(p, p+n);
+                return left > 0;
+            });
+        });
         return this;
     }
 
+    /* диапазоны: одна аллокация под итоговый размер и один сдвиг хвоста */
+    template<typename It> void InsertRange(size_t idx,It first,It last) {
+        if (idx>GetLength()) throw std::out_of_range("InsertRange: bad idx");
+        write().InsertRange(idx, first, last);
+    }
+    template<typename It> void AppendRange(It first,It last)  { write().AppendRange(first, last); }
+    template<typename It> void PrependRange(It first,It last) { write().PrependRange(first, last); }
+    T PopBack()  override { return write().PopBack(); }
+    T PopFront() override {
+        if (!GetLength()) throw std::out_of_range("PopFront: empty");
+        return write().RemoveAt(0);
+    }
+    T RemoveAt(size_t idx) override { return write().RemoveAt(idx); }
+    void EraseRange(size_t l,size_t r) override { write().Erase(l,r); }
+
     // immutable versions — create a copy then apply change
     SeqUPtr<T> Append(const T& v) const override {
         throw std::logic_error("MutableArraySequence: immutable operation not supported");
@@ -63,19 +112,22 @@ public:
     }
 
     /* service */
+    // срез без копирования; общий буфер копируется при первом изменении
     SeqUPtr<T> GetSubsequence(size_t l,size_t r) const override {
         if (l>r || r>=GetLength()) throw std::out_of_range("subseq: bad range");
-        auto res = SeqUPtr<T>(new MutableArraySequence);
-        for (size_t i=l;i<=r;++i) res->Append(data_[i]);
-        return res;
+        return SeqUPtr<T>(new SequenceSlice<T>(data_, l, r-l+1));
     }
+    const SharedArray<T>& Buffer() const { return data_; }
     SeqUPtr<T> Clone() const override {
         return SeqUPtr<T>(new MutableArraySequence(*this));
     }
     Sequence<T>* Instance() override { return this; }
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const override {
+        return data_.Read().NextChunk(c,p,n);
+    }
 
-    auto begin()       { return data_.begin(); }
-    auto end()         { return data_.end(); }
-    auto begin() const { return data_.begin(); }
-    auto end()   const { return data_.end(); }
+    auto begin()       { return write().begin(); }
+    auto end()         { return write().end(); }
+    auto begin() const { return data_.Read().begin(); }
+    auto end()   const { return data_.Read().end(); }
 };
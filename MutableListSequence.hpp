@@ -1,48 +1,71 @@
 #pragma once
 #include "Sequence.hpp"
 #include "LinkedList.hpp"
+#include "Stats.hpp"
 #include <stdexcept>
 #include <string>
 
-template<typename T>
-class MutableListSequence : public Sequence<T> {
-    LinkedList<T> list_;
+/* List — хранилище: LinkedList<T> или, например, LinkedList<T, NodePool>.
+   С -DSEQ_STATS Stats() считает копии списка immutable-операциями и GetSubsequence */
+template<typename T, typename List = LinkedList<T>>
+class MutableListSequence : public Sequence<T>, protected stats::Counters<stats::SequenceKind> {
+    List list_;
 public:
     /* ctors */
     MutableListSequence() = default;
     MutableListSequence(const T* p,size_t n): list_(p,n) {}
-    MutableListSequence(const LinkedList<T>& lst): list_(lst) {}
+    MutableListSequence(const List& lst): list_(lst) {}
+    MutableListSequence(List&& lst): list_(std::move(lst)) {}
     MutableListSequence(const MutableListSequence&)            = default;
     MutableListSequence& operator=(const MutableListSequence&) = default;
     MutableListSequence(MutableListSequence&&) noexcept        = default;
     MutableListSequence& operator=(MutableListSequence&&) noexcept = default;
 
     /* read */
+    using stats::Counters<stats::SequenceKind>::Stats;
     size_t GetLength()               const override { return list_.GetLength(); }
     const T& Get(size_t i)           const override { return list_.Get(i); }
-    T GetFirst()                     const override { return list_.GetFirst(); }
-    T GetLast()                      const override { return list_.GetLast();  }
+    const T& GetFirst()              const override { return list_.GetFirst(); }
+    const T& GetLast()               const override { return list_.GetLast();  }
 
     /* mutable */
     void Append (const T& v) override { list_.Append(v);   }
+    void Append (T&& v)      override { list_.Append(std::move(v));  }
     void Prepend(const T& v) override { list_.Prepend(v);  }
+    void Prepend(T&& v)      override { list_.Prepend(std::move(v)); }
     void InsertAt(const T& v,size_t i) override { list_.InsertAt(v,i); }
+    void InsertAt(T&& v,size_t i)      override { list_.InsertAt(std::move(v),i); }
+
+    /* на конкретном типе — сразу в узел, без промежуточного T */
+    template<typename... A> void EmplaceBack (A&&... a)        { list_.EmplaceBack(std::forward<A>(a)...); }
+    template<typename... A> void EmplaceFront(A&&... a)        { list_.EmplaceFront(std::forward<A>(a)...); }
+    template<typename... A> void EmplaceAt(size_t i, A&&... a) { list_.Emplace(i, std::forward<A>(a)...); }
+    // устойчивая сортировка самого списка (Sort.hpp)
+    template<typename Cmp> void Sort(Cmp cmp) { list_.Sort(cmp); }
     Sequence<T>* Concat(Sequence<T>* o) override {
-        for (size_t i=0;i<o->GetLength();++i) list_.Append(o->Get(i));
+        o->ForEach([this](const T& v) { list_.Append(v); });
         return this;
     }
+    T PopBack()  override { return list_.PopBack();  }
+    T PopFront() override { return list_.PopFront(); }
+    T RemoveAt(size_t i) override { return list_.RemoveAt(i); }
+    void EraseRange(size_t l,size_t r) override { list_.Erase(l,r); }
 
     /* immutable */
     SeqUPtr<T> Append (const T& v) const override {
+        stats::CountCopy<T>(*this, GetLength());
         auto cp = Clone(); cp->Append(v); return cp;
     }
     SeqUPtr<T> Prepend(const T& v) const override {
+        stats::CountCopy<T>(*this, GetLength());
         auto cp = Clone(); cp->Prepend(v); return cp;
     }
     SeqUPtr<T> InsertAt(const T& v,size_t i) const override {
+        stats::CountCopy<T>(*this, GetLength());
         auto cp = Clone(); cp->InsertAt(v,i); return cp;
     }
     SeqUPtr<T> Concat(const Sequence<T>* o) const override {
+        stats::CountCopy<T>(*this, GetLength());
         auto cp = Clone(); cp->Concat(const_cast<Sequence<T>*>(o)); return cp;
     }
 
@@ -50,10 +73,14 @@ public:
     SeqUPtr<T> GetSubsequence(size_t l,size_t r) const override {
         if (l>r || r>=GetLength())
             throw std::out_of_range("subseq: bad range");
-        return SeqUPtr<T>( new MutableListSequence(*list_.GetSubList(l,r)) );
+        stats::CountCopy<T>(*this, r-l+1);
+        return SeqUPtr<T>( new MutableListSequence(std::move(*std::unique_ptr<List>(list_.GetSubList(l,r)))) );
     }
     SeqUPtr<T> Clone()   const override { return SeqUPtr<T>(new MutableListSequence(*this)); }
     Sequence<T>* Instance() override    { return this; }
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const override {
+        return list_.NextChunk(c,p,n);
+    }
 
     auto begin()       { return list_.begin(); }
     auto end()         { return list_.end();   }
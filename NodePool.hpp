@@ -0,0 +1,83 @@
+#pragma once
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/* Политики выделения узлов для LinkedList<T, NodeAlloc>.
+   Интерфейс: New(args...) -> Node*, Delete(Node*), Release() — вернуть всю
+   память (узлы к этому моменту уже разрушены), swap(other).
+   kBulkRelease == true: Release() освобождает память без обхода узлов. */
+
+/* по узлу на new/delete — поведение по умолчанию */
+template<class Node>
+struct HeapNodeAlloc {
+    static constexpr bool kBulkRelease = false;
+
+    template<class... A>
+    Node* New(A&&... a) { return new Node(std::forward<A>(a)...); }
+    void  Delete(Node* n) { delete n; }
+    void  Release() {}
+    void  swap(HeapNodeAlloc&) noexcept {}
+};
+
+/* узлы нарезаются из крупных слэбов (64, 128, ... до 64K узлов), освобождённые
+   идут в свободный список, слэбы отдаются целиком в Release/деструкторе */
+template<class Node>
+class NodePool {
+    union Slot {
+        Slot* next;
+        alignas(Node) unsigned char raw[sizeof(Node)];
+    };
+    static constexpr size_t kFirstSlab = 64;
+    static constexpr size_t kMaxSlab   = 65536;
+
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    Slot*  free_     = nullptr;
+    Slot*  bump_     = nullptr;   // нетронутый остаток последнего слэба
+    Slot*  bumpEnd_  = nullptr;
+    size_t nextSlab_ = kFirstSlab;
+
+    Slot* grab() {
+        if (free_) { Slot* s = free_; free_ = s->next; return s; }
+        if (bump_ == bumpEnd_) {
+            slabs_.emplace_back(new Slot[nextSlab_]);
+            bump_ = slabs_.back().get(); bumpEnd_ = bump_ + nextSlab_;
+            if (nextSlab_ < kMaxSlab) nextSlab_ *= 2;
+        }
+        return bump_++;
+    }
+
+public:
+    static constexpr bool kBulkRelease = true;
+
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;             // пул принадлежит одному списку
+    NodePool& operator=(const NodePool&) = delete;
+
+    template<class... A>
+    Node* New(A&&... a) {
+        Slot* s = grab();
+        try { return ::new (static_cast<void*>(s->raw)) Node(std::forward<A>(a)...); }
+        catch (...) { s->next = free_; free_ = s; throw; }
+    }
+    void Delete(Node* n) {
+        n->~Node();
+        Slot* s = reinterpret_cast<Slot*>(n);
+        s->next = free_; free_ = s;
+    }
+    void Release() {
+        slabs_.clear();
+        free_ = bump_ = bumpEnd_ = nullptr;
+        nextSlab_ = kFirstSlab;
+    }
+    size_t SlabCount() const { return slabs_.size(); }
+
+    void swap(NodePool& o) noexcept {
+        slabs_.swap(o.slabs_);
+        std::swap(free_, o.free_);
+        std::swap(bump_, o.bump_);
+        std::swap(bumpEnd_, o.bumpEnd_);
+        std::swap(nextSlab_, o.nextSlab_);
+    }
+};
@@ -0,0 +1,96 @@
+#pragma once
+#include "Sequence.hpp"
+#include "PersistentVector.hpp"
+#include <stdexcept>
+#include <string>
+
+/* Immutable-последовательность на PersistentVector: Append — O(1) амортизированно,
+   Clone — O(1), все версии делят общие узлы. Prepend/InsertAt пересобирают
+   вектор за O(n) (32-арное дерево не умеет сдвиг), но без копирования
+   каждого элемента на каждом шаге, как ImmutableArraySequence. */
+template<typename T>
+class PersistentArraySequence : public Sequence<T> {
+    PersistentVector<T> data_;
+
+    // куски [l, r) data_ дописываются в out
+    void appendRange(PersistentVector<T>& out, size_t l, size_t r) const {
+        ChunkCursor c; c.pos = l;
+        const T* p; size_t n;
+        while (c.pos < r && data_.NextChunk(c, p, n)) {
+            size_t take = std::min(n, r - (c.pos - n));
+            out = out.AppendRange(p, take);
+        }
+    }
+public:
+    PersistentArraySequence() = default;
+    PersistentArraySequence(const T* p,size_t n): data_(p,n) {}
+    explicit PersistentArraySequence(PersistentVector<T> v): data_(std::move(v)) {}
+
+    const PersistentVector<T>& Data() const { return data_; }
+
+    /* read */
+    size_t GetLength()               const override { return data_.GetSize(); }
+    const T& Get(size_t i)           const override { return data_[i]; }
+    const T& GetFirst()              const override {
+        if (!GetLength()) throw std::out_of_range("empty");
+        return Get(0);
+    }
+    const T& GetLast()               const override {
+        if (!GetLength()) throw std::out_of_range("empty");
+        return Get(GetLength()-1);
+    }
+
+    /* immutable ops — новые версии со структурным разделением */
+    SeqUPtr<T> Append (const T& v) const override {
+        return SeqUPtr<T>(new PersistentArraySequence(data_.PushBack(v)));
+    }
+    SeqUPtr<T> Prepend(const T& v) const override { return InsertAt(v, 0); }
+    SeqUPtr<T> InsertAt(const T& v,size_t i) const override {
+        if (i>GetLength()) throw std::out_of_range("InsertAt: bad idx");
+        PersistentVector<T> out;
+        appendRange(out, 0, i);
+        out = out.PushBack(v);
+        appendRange(out, i, GetLength());
+        return SeqUPtr<T>(new PersistentArraySequence(std::move(out)));
+    }
+    SeqUPtr<T> Concat(const Sequence<T>* o) const override {
+        PersistentVector<T> out = data_;
+        o->ForEachChunk([&](const T* p, size_t n) { out = out.AppendRange(p, n); return true; });
+        return SeqUPtr<T>(new PersistentArraySequence(std::move(out)));
+    }
+    // замена элемента — O(log32 n)
+    SeqUPtr<T> Set(size_t i,const T& v) const {
+        return SeqUPtr<T>(new PersistentArraySequence(data_.Set(i, v)));
+    }
+    SeqUPtr<T> WithoutLast() const {
+        return SeqUPtr<T>(new PersistentArraySequence(data_.PopBack()));
+    }
+
+    /* mutable ops — запрещены */
+    void Append (const T&) override { throw std::logic_error("immutable"); }
+    void Prepend(const T&) override { throw std::logic_error("immutable"); }
+    void InsertAt(const T&,size_t) override { throw std::logic_error("immutable"); }
+    Sequence<T>* Concat(Sequence<T>*) override { throw std::logic_error("immutable"); }
+    T PopBack()  override { throw std::logic_error("immutable"); }
+    T PopFront() override { throw std::logic_error("immutable"); }
+    T RemoveAt(size_t) override { throw std::logic_error("immutable"); }
+    void EraseRange(size_t,size_t) override { throw std::logic_error("immutable"); }
+
+    /* service */
+    SeqUPtr<T> GetSubsequence(size_t l,size_t r) const override {
+        if (l>r || r>=GetLength()) throw std::out_of_range("subseq: bad range");
+        if (l == 0) {                                   // префикс — общие узлы, отрезаем хвост
+            PersistentVector<T> out = data_;
+            while (out.GetSize() > r + 1 && out.GetSize() - (r + 1) < 64) out = out.PopBack();
+            if (out.GetSize() == r + 1) return SeqUPtr<T>(new PersistentArraySequence(std::move(out)));
+        }
+        PersistentVector<T> out;
+        appendRange(out, l, r + 1);
+        return SeqUPtr<T>(new PersistentArraySequence(std::move(out)));
+    }
+    SeqUPtr<T> Clone() const override { return SeqUPtr<T>(new PersistentArraySequence(*this)); }
+    Sequence<T>* Instance() override  { return Clone().release(); }
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const override {
+        return data_.NextChunk(c,p,n);
+    }
+};
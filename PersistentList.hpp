@@ -0,0 +1,169 @@
+#pragma once
+#include "BoundsCheck.hpp"
+#include "ChunkCursor.hpp"
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+/* Персистентный односвязный список с общими хвостами (cons-список).
+   Копия объекта — O(1): версии делят узлы (счётчик ссылок на узел).
+   Каждая версия знает свою длину и никогда не заходит за неё, поэтому
+   Append может дописать узел прямо за последним общим узлом, если его next
+   ещё свободен (CAS); иначе копируется префикс. Prepend — O(1), InsertAt(i)
+   копирует i узлов, GetSubList ничего не копирует.
+   Интерфейс — как у LinkedList, чтобы подставляться в ImmutableListSequence. */
+template<typename T>
+class PersistentList {
+    struct Node {
+        std::atomic<size_t> refs{1};
+        std::atomic<Node*>  next{nullptr};      // ссылка-владелец на следующий узел
+        T val;
+        explicit Node(const T& v): val(v) {}
+    };
+
+    Node*  head_ = nullptr;
+    Node*  last_ = nullptr;                     // узел с индексом len_-1 этой версии
+    size_t len_  = 0;
+
+    static void retain(Node* n) { if (n) n->refs.fetch_add(1, std::memory_order_relaxed); }
+    // без рекурсии: длинная цепочка не переполнит стек
+    static void release(Node* n) {
+        while (n && n->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Node* nx = n->next.load(std::memory_order_relaxed);
+            delete n;
+            n = nx;
+        }
+    }
+    void range_check(size_t i) const { if (i >= len_) detail::ThrowIndexOutOfRange(i, len_, "length"); }
+    Node* nodeAt(size_t i) const {
+        Node* p = head_;
+        while (i--) p = p->next.load(std::memory_order_acquire);
+        return p;
+    }
+    // копии первых k узлов, последняя смотрит на rest (ссылку на rest забирает цепочка)
+    Node* copyPrefix(size_t k, Node* rest) const {
+        if (!k) return rest;
+        Node* first = nullptr; Node* prev = nullptr;
+        const Node* src = head_;
+        try {
+            for (size_t i = 0; i < k; ++i, src = src->next.load(std::memory_order_acquire)) {
+                Node* c = new Node(src->val);
+                if (prev) prev->next.store(c, std::memory_order_relaxed); else first = c;
+                prev = c;
+            }
+        } catch (...) { release(first); throw; }
+        prev->next.store(rest, std::memory_order_release);
+        return first;
+    }
+
+public:
+    /* --- ctors/dtor --- */
+    PersistentList() = default;
+    PersistentList(const T* src,size_t n){ for(size_t i=0;i<n;++i) Append(src[i]); }
+
+    PersistentList(const PersistentList& o): head_(o.head_), last_(o.last_), len_(o.len_) { retain(head_); }
+    PersistentList& operator=(PersistentList rhs){ swap(rhs); return *this; }
+    PersistentList(PersistentList&& o) noexcept { swap(o); }
+
+    ~PersistentList(){ release(head_); }
+
+    /* --- read --- */
+    size_t   GetLength() const { return len_; }
+    const T& GetFirst()  const {
+        if(!head_) throw std::out_of_range("GetFirst: empty list");
+        return head_->val;
+    }
+    const T& GetLast()   const {
+        if(!last_) throw std::out_of_range("GetLast: empty list");
+        return last_->val;
+    }
+    const T& Get(size_t idx) const { range_check(idx); return nodeAt(idx)->val; }
+
+    /* --- блочный обход: по узлу за раз, c.node — следующий узел --- */
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const {
+        if(c.pos >= len_) return false;
+        const Node* node = c.pos ? static_cast<const Node*>(c.node) : head_;
+        p = &node->val; n = 1;
+        c.node = node->next.load(std::memory_order_acquire); ++c.pos;
+        return true;
+    }
+
+    /* --- изменения видны только этой версии --- */
+    void Prepend(const T& v){
+        Node* n = new Node(v);
+        n->next.store(head_, std::memory_order_relaxed);    // наша ссылка на head_ переходит в узел
+        head_ = n;
+        if(!last_) last_ = n;
+        ++len_;
+    }
+    void Append(const T& v){
+        Node* n = new Node(v);
+        if(!len_){ head_ = last_ = n; len_ = 1; return; }
+        Node* expect = nullptr;
+        if(!last_->next.compare_exchange_strong(expect, n, std::memory_order_acq_rel)){
+            Node* h;                                        // за last_ уже дописала другая версия
+            try { h = copyPrefix(len_, n); } catch (...) { delete n; throw; }
+            release(head_);
+            head_ = h;
+        }
+        last_ = n;
+        ++len_;
+    }
+    void InsertAt(const T& v,size_t i){
+        if(i>len_) throw std::out_of_range("InsertAt: bad idx");
+        if(i==0){ Prepend(v); return; }
+        if(i==len_){ Append(v); return; }
+        Node* rest = nodeAt(i);
+        retain(rest);
+        Node* n;
+        try { n = new Node(v); } catch (...) { release(rest); throw; }
+        n->next.store(rest, std::memory_order_relaxed);
+        Node* h;
+        try { h = copyPrefix(i, n); } catch (...) { release(n); throw; }
+        release(head_);
+        head_ = h;
+        ++len_;
+    }
+    T PopFront(){
+        if(!head_) throw std::out_of_range("PopFront: empty list");
+        T v = head_->val;
+        Node* old = head_;
+        if(--len_){ head_ = old->next.load(std::memory_order_acquire); retain(head_); }
+        else head_ = last_ = nullptr;
+        release(old);
+        return v;
+    }
+
+    // подсписок [l, r] делит узлы с этой версией — O(r), без копий
+    PersistentList* GetSubList(size_t l,size_t r) const{
+        if(l>r||r>=len_) throw std::out_of_range("GetSubList: bad range");
+        auto* res = new PersistentList;
+        res->head_ = nodeAt(l);
+        retain(res->head_);
+        res->last_ = r + 1 == len_ ? last_ : nodeAt(r);
+        res->len_ = r-l+1;
+        return res;
+    }
+    PersistentList* Concat(const PersistentList* o) const{
+        auto* res = new PersistentList(*this);
+        for(const auto& v:*o) res->Append(v);
+        return res;
+    }
+
+    /* --- simple iterator (идёт по длине версии, а не до nullptr) --- */
+    class cit{
+        const Node* p; size_t left;
+    public:
+        cit(const Node* n,size_t k):p(n),left(k){}
+        cit& operator++(){ if(--left) p=p->next.load(std::memory_order_acquire); return *this; }
+        bool operator!=(const cit& o)const{ return left!=o.left; }
+        const T& operator*() const { return p->val; }
+    };
+    cit begin() const { return cit(head_, len_); }  cit end() const { return cit(nullptr, 0); }
+
+    void swap(PersistentList& o) noexcept {
+        std::swap(head_,o.head_); std::swap(last_,o.last_); std::swap(len_,o.len_);
+    }
+};
@@ -0,0 +1,253 @@
+#pragma once
+#include "BoundsCheck.hpp"
+#include "ChunkCursor.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+/* Персистентный вектор: 32-арное префиксное дерево + хвостовой лист
+   (как в Clojure). Каждая операция возвращает новую версию, старые остаются
+   валидными и делят с ней все неизменённые узлы (счётчик ссылок на узел).
+   Get/Set/PopBack — O(log32 n), PushBack — O(1) амортизированно:
+   элемент дописывается прямо в общий хвост, если его слот ещё никто не занял
+   (CAS по count), иначе хвост копируется. */
+template<typename T>
+class PersistentVector {
+    static constexpr unsigned kBits  = 5;
+    static constexpr size_t   kWidth = size_t(1) << kBits;
+    static constexpr size_t   kMask  = kWidth - 1;
+
+    struct Node {
+        std::atomic<uint32_t> refs{1};
+        std::atomic<uint32_t> count{0};     // занятые слоты; у листа — сконструированные элементы
+    };
+    struct Inner : Node { Node* kid[kWidth]; };
+    struct Leaf  : Node {
+        alignas(T) unsigned char raw[kWidth * sizeof(T)];
+        T*       at(size_t i)       { return reinterpret_cast<T*>(raw) + i; }
+        const T* at(size_t i) const { return reinterpret_cast<const T*>(raw) + i; }
+    };
+
+    Node*    root_  = nullptr;              // Inner высоты shift_; nullptr, пока всё в хвосте
+    Leaf*    tail_  = nullptr;
+    size_t   size_  = 0;
+    unsigned shift_ = kBits;
+
+    /* --- узлы --- */
+    static void retain(Node* n) { if (n) n->refs.fetch_add(1, std::memory_order_relaxed); }
+    // level 0 — лист; у внутреннего узла уровня L дети уровня L - kBits
+    static void release(Node* n, unsigned level) {
+        if (!n || n->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        if (level == 0) {
+            Leaf* l = static_cast<Leaf*>(n);
+            for (size_t i = 0, k = l->count.load(std::memory_order_relaxed); i < k; ++i) l->at(i)->~T();
+            delete l;
+        } else {
+            Inner* in = static_cast<Inner*>(n);
+            for (size_t i = 0, k = in->count.load(std::memory_order_relaxed); i < k; ++i)
+                release(in->kid[i], level - kBits);
+            delete in;
+        }
+    }
+    static Leaf* copyLeaf(const Leaf* src, size_t k) {
+        Leaf* l = new Leaf;
+        size_t i = 0;
+        try { for (; i < k; ++i) ::new (l->at(i)) T(*src->at(i)); }
+        catch (...) { while (i) l->at(--i)->~T(); delete l; throw; }
+        l->count.store(uint32_t(k), std::memory_order_relaxed);
+        return l;
+    }
+    static Inner* copyInner(const Inner* src) {
+        Inner* r = new Inner;
+        size_t k = src->count.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < k; ++i) { r->kid[i] = src->kid[i]; retain(r->kid[i]); }
+        r->count.store(uint32_t(k), std::memory_order_relaxed);
+        return r;
+    }
+    static Node* newPath(unsigned level, Node* leaf) {
+        if (level == 0) return leaf;
+        Inner* r = new Inner;
+        r->kid[0] = newPath(level - kBits, leaf);
+        r->count.store(1, std::memory_order_relaxed);
+        return r;
+    }
+
+    size_t tailOffset() const { return size_ < kWidth ? 0 : ((size_ - 1) & ~kMask); }
+    void check(size_t i) const { if (i >= size_) detail::ThrowIndexOutOfRange(i, size_); }
+    const Leaf* leafFor(size_t i) const {
+        if (i >= tailOffset()) return tail_;
+        const Node* n = root_;
+        for (unsigned lv = shift_; lv > 0; lv -= kBits) n = static_cast<const Inner*>(n)->kid[(i >> lv) & kMask];
+        return static_cast<const Leaf*>(n);
+    }
+
+    /* --- изменения на месте: трогают только эту версию (копии путей) --- */
+    Inner* pushTail(unsigned level, const Inner* parent, Leaf* full) const {
+        size_t sub = ((size_ - 1) >> level) & kMask;
+        Inner* r = copyInner(parent);
+        Node* ins;
+        if (level == kBits) ins = full;
+        else if (sub < parent->count.load(std::memory_order_relaxed)) {
+            Node* old = r->kid[sub];
+            ins = pushTail(level - kBits, static_cast<const Inner*>(old), full);
+            release(old, level - kBits);
+        } else ins = newPath(level - kBits, full);
+        r->kid[sub] = ins;
+        if (sub >= r->count.load(std::memory_order_relaxed)) r->count.store(uint32_t(sub + 1), std::memory_order_relaxed);
+        return r;
+    }
+    void push(const T& v) {
+        const size_t tlen = size_ - tailOffset();
+        if (tail_ && tlen < kWidth) {
+            uint32_t expect = uint32_t(tlen);
+            if (tail_->count.compare_exchange_strong(expect, expect + 1, std::memory_order_acq_rel)) {
+                try { ::new (tail_->at(tlen)) T(v); }
+                catch (...) { tail_->count.store(uint32_t(tlen), std::memory_order_release); throw; }
+                ++size_;
+                return;
+            }
+            Leaf* t = copyLeaf(tail_, tlen);        // слот уже занят другой версией
+            try { ::new (t->at(tlen)) T(v); } catch (...) { release(t, 0); throw; }
+            t->count.store(uint32_t(tlen + 1), std::memory_order_relaxed);
+            release(tail_, 0);
+            tail_ = t;
+            ++size_;
+            return;
+        }
+        Leaf* t = new Leaf;
+        try { ::new (t->at(0)) T(v); } catch (...) { delete t; throw; }
+        t->count.store(1, std::memory_order_relaxed);
+        if (tail_) {                                // полный хвост уходит в дерево (вместе с нашей ссылкой)
+            if (!root_) {
+                Inner* r = new Inner;
+                r->kid[0] = tail_;
+                r->count.store(1, std::memory_order_relaxed);
+                root_ = r;
+            } else if ((size_ >> kBits) > (size_t(1) << shift_)) {   // корень заполнен — дерево растёт вверх
+                Inner* r = new Inner;
+                r->kid[0] = root_;
+                r->kid[1] = newPath(shift_, tail_);
+                r->count.store(2, std::memory_order_relaxed);
+                root_ = r;
+                shift_ += kBits;
+            } else {
+                Inner* r = pushTail(shift_, static_cast<const Inner*>(root_), tail_);
+                release(root_, shift_);
+                root_ = r;
+            }
+        }
+        tail_ = t;
+        ++size_;
+    }
+    Node* assign(unsigned level, const Node* n, size_t i, const T& v) const {
+        if (level == 0) {
+            Leaf* l = copyLeaf(static_cast<const Leaf*>(n), kWidth);
+            try { *l->at(i & kMask) = v; } catch (...) { release(l, 0); throw; }
+            return l;
+        }
+        Inner* r = copyInner(static_cast<const Inner*>(n));
+        size_t sub = (i >> level) & kMask;
+        Node* old = r->kid[sub];
+        try { r->kid[sub] = assign(level - kBits, old, i, v); } catch (...) { release(r, level); throw; }
+        release(old, level - kBits);
+        return r;
+    }
+    // путь к последнему листу без него; nullptr, если узел опустел
+    Node* popTail(unsigned level, const Node* n) const {
+        size_t sub = ((size_ - 2) >> level) & kMask;
+        const Inner* in = static_cast<const Inner*>(n);
+        if (level > kBits) {
+            Node* child = popTail(level - kBits, in->kid[sub]);
+            if (!child && sub == 0) return nullptr;
+            Inner* r = copyInner(in);
+            release(r->kid[sub], level - kBits);
+            if (child) r->kid[sub] = child;
+            else       r->count.store(uint32_t(sub), std::memory_order_relaxed);
+            return r;
+        }
+        if (sub == 0) return nullptr;
+        Inner* r = copyInner(in);
+        release(r->kid[sub], 0);
+        r->count.store(uint32_t(sub), std::memory_order_relaxed);
+        return r;
+    }
+    void pop() {
+        if (!size_) throw std::out_of_range("PopBack: empty");
+        if (size_ - tailOffset() > 1 || size_ == 1) {   // элемент остаётся в общем хвосте, эта версия его не видит
+            if (--size_ == 0) { release(tail_, 0); tail_ = nullptr; }
+            return;
+        }
+        Leaf* nt = const_cast<Leaf*>(leafFor(size_ - 2));
+        retain(nt);
+        Node* nr = popTail(shift_, root_);
+        release(root_, shift_);
+        root_ = nr;
+        if (!root_) shift_ = kBits;
+        else if (shift_ > kBits && static_cast<Inner*>(root_)->count.load(std::memory_order_relaxed) == 1) {
+            Node* child = static_cast<Inner*>(root_)->kid[0];
+            retain(child);
+            release(root_, shift_);
+            root_ = child;
+            shift_ -= kBits;
+        }
+        release(tail_, 0);
+        tail_ = nt;
+        --size_;
+    }
+
+public:
+    PersistentVector() = default;
+    PersistentVector(const T* p, size_t n) { for (size_t i = 0; i < n; ++i) push(p[i]); }
+    PersistentVector(const PersistentVector& o)
+        : root_(o.root_), tail_(o.tail_), size_(o.size_), shift_(o.shift_) { retain(root_); retain(tail_); }
+    PersistentVector(PersistentVector&& o) noexcept { swap(o); }
+    PersistentVector& operator=(PersistentVector o) noexcept { swap(o); return *this; }
+    ~PersistentVector() { release(root_, shift_); release(tail_, 0); }
+
+    void swap(PersistentVector& o) noexcept {
+        std::swap(root_, o.root_); std::swap(tail_, o.tail_);
+        std::swap(size_, o.size_); std::swap(shift_, o.shift_);
+    }
+
+    /* --- access --- */
+    size_t GetSize() const { return size_; }
+    const T& operator[](size_t i) const { check(i); return *leafFor(i)->at(i & kMask); }
+
+    /* --- новые версии (this не меняется) --- */
+    PersistentVector PushBack(const T& v) const { PersistentVector r(*this); r.push(v); return r; }
+    PersistentVector AppendRange(const T* p, size_t n) const {
+        PersistentVector r(*this);
+        for (size_t i = 0; i < n; ++i) r.push(p[i]);
+        return r;
+    }
+    PersistentVector Set(size_t i, const T& v) const {
+        check(i);
+        PersistentVector r(*this);
+        if (i >= tailOffset()) {
+            Leaf* t = copyLeaf(tail_, size_ - tailOffset());
+            try { *t->at(i & kMask) = v; } catch (...) { release(t, 0); throw; }
+            release(r.tail_, 0);
+            r.tail_ = t;
+        } else {
+            Node* nr = assign(shift_, root_, i, v);
+            release(r.root_, shift_);
+            r.root_ = nr;
+        }
+        return r;
+    }
+    PersistentVector PopBack() const { PersistentVector r(*this); r.pop(); return r; }
+
+    /* блочный обход: по листу за раз, курсор — индекс следующего элемента */
+    bool NextChunk(ChunkCursor& c, const T*& p, size_t& n) const {
+        if (c.pos >= size_) return false;
+        p = leafFor(c.pos)->at(c.pos & kMask);
+        n = std::min(kWidth - (c.pos & kMask), size_ - c.pos);
+        c.pos += n;
+        return true;
+    }
+};
@@ -1,26 +1,89 @@
 #pragma once
+#include "Sequence.hpp"
 #include <vector>
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <iterator>
 
 template<class T, class Compare = std::less<T>>
 class PriorityQueue {
 private:
     std::vector<T> data;
     Compare cmp;
+
+    // k новых элементов уже в хвосте data: выбираем между push_heap на каждый
+    // (O(k log n)) и перестройкой всей кучи по Флойду (O(n))
+    void heapifyTail(size_t k) {
+        size_t n = data.size(), lg = 1;
+        while ((size_t(1) << lg) < n) ++lg;
+        if (k * lg >= n) {
+            std::make_heap(data.begin(), data.end(), cmp);
+        } else {
+            for (size_t i = n - k; i < n; ++i)
+                std::push_heap(data.begin(), data.begin() + i + 1, cmp);
+        }
+    }
 public:
     PriorityQueue() = default;
+    template<class It>
+    PriorityQueue(It first, It last, Compare c = Compare()) : data(first, last), cmp(c) {
+        std::make_heap(data.begin(), data.end(), cmp);
+    }
+    explicit PriorityQueue(const Sequence<T>& seq, Compare c = Compare()) : cmp(c) {
+        data.reserve(seq.GetLength());
+        for (const T& v : seq) data.push_back(v);
+        std::make_heap(data.begin(), data.end(), cmp);
+    }
+
     void Push(const T& item) {
         data.push_back(item);
         std::push_heap(data.begin(), data.end(), cmp);
     }
+    void Push(T&& item) {
+        data.push_back(std::move(item));
+        std::push_heap(data.begin(), data.end(), cmp);
+    }
+    template<class... A>
+    void Emplace(A&&... a) {
+        data.emplace_back(std::forward<A>(a)...);
+        std::push_heap(data.begin(), data.end(), cmp);
+    }
+    const T& Top() const {
+        assert(!data.empty());
+        return data.front();
+    }
+    template<class It>
+    void PushRange(It first, It last) {
+        size_t old = data.size();
+        data.insert(data.end(), first, last);
+        if (data.size() > old) heapifyTail(data.size() - old);
+    }
+    void PushRange(const Sequence<T>& seq) {
+        data.reserve(data.size() + seq.GetLength());
+        for (const T& v : seq) data.push_back(v);
+        if (seq.GetLength()) heapifyTail(seq.GetLength());
+    }
+
     T Pop() {
         assert(!data.empty());
         std::pop_heap(data.begin(), data.end(), cmp);
-        T item = data.back(); data.pop_back();
+        T item = std::move(data.back()); data.pop_back();
         return item;
     }
+    // снимает до k старших элементов move-ом в out (по убыванию приоритета),
+    // возвращает сколько снято
+    template<class OutIt>
+    size_t PopN(size_t k, OutIt out) {
+        size_t cnt = std::min(k, data.size());
+        for (size_t i = 0; i < cnt; ++i) {
+            std::pop_heap(data.begin(), data.end(), cmp);
+            *out++ = std::move(data.back());
+            data.pop_back();
+        }
+        return cnt;
+    }
+
     size_t Size() const { return data.size(); }
     void Print() const {
         for (const auto& item : data) std::cout << item << ' ';
@@ -1,27 +1,30 @@
 #pragma once
 #include "Sequence.hpp"
-#include "MutableArraySequence.hpp"
+#include "CircularArraySequence.hpp"
+#include "Stats.hpp"
 #include <cassert>
 #include <iostream>
 
+/* с -DSEQ_STATS Stats() считает вставки, снятия и снятия, перестроившие хранилище */
 template<class T>
-class Queue {
+class Queue : protected stats::Counters<stats::AdapterKind> {
+    using K = stats::AdapterKind;
 private:
     std::unique_ptr<Sequence<T>> seq;
 public:
-    Queue() : seq(new MutableArraySequence<T>()) {}
-    void Enqueue(const T& item) { seq->Append(item); }
+    Queue() : seq(new CircularArraySequence<T>()) {}
+    void Enqueue(const T& item) { Add(K::Pushes); seq->Append(item); }
+    void Enqueue(T&& item)      { Add(K::Pushes); seq->Append(std::move(item)); }
+    template<class... A> void Emplace(A&&... a) { Add(K::Pushes); seq->EmplaceBack(std::forward<A>(a)...); }
+    const T& Front() const {
+        assert(seq->GetLength() > 0);
+        return seq->GetFirst();
+    }
     T Dequeue() {
         assert(seq->GetLength() > 0);
-        T item = seq->Get(0);
-        size_t len = seq->GetLength();
-        if (len > 1) {
-            seq = seq->GetSubsequence(1, len - 1);
-        } else {
-            seq.reset(new MutableArraySequence<T>());
-        }
-        return item;
+        return stats::CountPop(*this, [this] { return seq->PopFront(); });
     }
+    using stats::Counters<K>::Stats;
     size_t Size() const { return seq->GetLength(); }
     void Print() const {
         size_t n = seq->GetLength();
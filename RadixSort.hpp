@@ -0,0 +1,244 @@
+#pragma once
+#include "Sort.hpp"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Поразрядная сортировка по ключу key(const T&).
+   Ключ — целое (знаковое или нет), float/double или std::pair / std::tuple
+   из них (лексикографически, первое поле старшее). Каждое поле кодируется
+   в беззнаковое число того же размера с тем же порядком: у знаковых
+   переворачивается старший бит, у вещественных — все биты отрицательных
+   и знаковый бит положительных (-0.0 < +0.0, NaN — по краям).
+
+     RadixSort    — LSD, устойчивая: по проходу на разряд, через буфер
+                    размером с массив. Сначала один проход считает гистограммы
+                    всех разрядов поля, и проходы, где все элементы попадают
+                    в одну корзину, пропускаются (старшие нули, общий префикс);
+     RadixSortMsd — MSD на месте (American flag sort), без буфера, неустойчивая;
+                    корзины меньше kMsdCutoff доупорядочиваются PdqSort.
+   Ширина разряда — RadixOptions::DigitBits (8, 11 или 16): 8 бит — гистограмма
+   в L1, 16 — вдвое меньше проходов для 32-битных ключей. С Pool гистограммы LSD
+   считаются параллельно по кускам Grain, раскладка остаётся последовательной. */
+
+struct RadixOptions {
+    unsigned    DigitBits = 8;
+    ThreadPool* Pool      = nullptr;
+    Grain       Chunk     = Grain();
+};
+
+namespace radix {
+
+constexpr size_t kMsdCutoff = 64;
+
+template<typename K, typename = void> struct Traits;
+
+template<typename K>
+struct Traits<K, std::enable_if_t<std::is_integral_v<K>>> {
+    static_assert(!std::is_same_v<K, bool>, "radix: bool key");
+    using U = std::make_unsigned_t<K>;
+    static U Encode(K k) {
+        if constexpr (std::is_signed_v<K>) return U(U(k) ^ (U(1) << (sizeof(K) * 8 - 1)));
+        else return k;
+    }
+};
+
+template<typename K>
+struct Traits<K, std::enable_if_t<std::is_floating_point_v<K>>> {
+    static_assert(sizeof(K) == 4 || sizeof(K) == 8, "radix: only float and double");
+    using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+    static U Encode(K k) {
+        U u;
+        std::memcpy(&u, &k, sizeof u);
+        const U sign = U(1) << (sizeof(U) * 8 - 1);
+        return (u & sign) ? U(~u) : U(u | sign);
+    }
+};
+
+// поля составного ключа; одиночный ключ — одно поле
+template<typename K> struct Fields {
+    static constexpr size_t N = 1;
+    template<size_t I> static const K& Get(const K& k) { return k; }
+};
+template<typename... F> struct Fields<std::tuple<F...>> {
+    static constexpr size_t N = sizeof...(F);
+    template<size_t I> static const auto& Get(const std::tuple<F...>& k) { return std::get<I>(k); }
+};
+template<typename A, typename B> struct Fields<std::pair<A, B>> {
+    static constexpr size_t N = 2;
+    template<size_t I> static const auto& Get(const std::pair<A, B>& k) { return std::get<I>(k); }
+};
+
+/* поле I ключа элемента в кодировке Traits */
+template<typename T, typename Key>
+struct KeyCodec {
+    using K = std::decay_t<std::invoke_result_t<Key&, const T&>>;
+    static constexpr size_t N = Fields<K>::N;
+    template<size_t I> using F = std::decay_t<decltype(Fields<K>::template Get<I>(std::declval<const K&>()))>;
+    template<size_t I> using U = typename Traits<F<I>>::U;
+
+    Key& key;
+    template<size_t I> U<I> Field(const T& v) const { return Traits<F<I>>::Encode(Fields<K>::template Get<I>(key(v))); }
+
+    // лексикографическое сравнение закодированных полей, начиная с I
+    template<size_t I = 0>
+    bool Less(const T& a, const T& b) const {
+        if constexpr (I == N) return false;
+        else {
+            U<I> x = Field<I>(a), y = Field<I>(b);
+            return x != y ? x < y : Less<I + 1>(a, b);
+        }
+    }
+};
+
+inline void CheckDigits(unsigned r) {
+    if (r < 1 || r > 16) throw std::invalid_argument("RadixSort: DigitBits must be in [1, 16]");
+}
+
+/* ---------- LSD ---------- */
+template<size_t I, typename T, typename Key>
+void LsdField(T*& src, T*& dst, size_t n, const KeyCodec<T, Key>& kc, const RadixOptions& opt) {
+    using U = typename KeyCodec<T, Key>::template U<I>;
+    const unsigned r = opt.DigitBits, bits = sizeof(U) * 8, passes = (bits + r - 1) / r;
+    const size_t R = size_t(1) << r;
+    const U mask = U(R - 1);
+
+    // гистограммы всех разрядов поля за один проход
+    std::vector<size_t> hist(passes * R, 0);
+    auto count = [&](const T* p, size_t m, size_t* h) {
+        for (size_t i = 0; i < m; ++i) {
+            U u = kc.template Field<I>(p[i]);
+            for (unsigned k = 0; k < passes; ++k) ++h[k * R + ((u >> (k * r)) & mask)];
+        }
+    };
+    ThreadPool* pool = opt.Pool;
+    const size_t chunk = pool ? opt.Chunk.ChunkFor(n, pool->Size()) : n;
+    if (pool && pool->Size() > 1 && n > chunk) {
+        std::vector<std::vector<size_t>> part((n + chunk - 1) / chunk);
+        pool->ParallelFor(n, chunk, [&](size_t b, size_t e) {
+            auto& h = part[b / chunk];
+            h.assign(hist.size(), 0);
+            count(src + b, e - b, h.data());
+        });
+        for (const auto& h : part)
+            for (size_t i = 0; i < hist.size(); ++i) hist[i] += h[i];
+    } else {
+        count(src, n, hist.data());
+    }
+
+    for (unsigned k = 0; k < passes; ++k) {
+        size_t* h = hist.data() + k * R;
+        if (std::find(h, h + R, n) != h + R) continue;      // разряд у всех одинаковый
+        for (size_t d = 0, at = 0; d < R; ++d) { size_t c = h[d]; h[d] = at; at += c; }
+        for (size_t i = 0; i < n; ++i) {
+            size_t d = (kc.template Field<I>(src[i]) >> (k * r)) & mask;
+            dst[h[d]++] = std::move(src[i]);
+        }
+        std::swap(src, dst);
+    }
+}
+
+// поля от младшего к старшему: устойчивость прохода сохраняет порядок младших
+template<size_t I, typename T, typename Key>
+void LsdFields(T*& src, T*& dst, size_t n, const KeyCodec<T, Key>& kc, const RadixOptions& opt) {
+    LsdField<I>(src, dst, n, kc, opt);
+    if constexpr (I > 0) LsdFields<I - 1>(src, dst, n, kc, opt);
+}
+
+template<typename T, typename Key>
+void LsdSort(T* a, size_t n, Key& key, const RadixOptions& opt) {
+    CheckDigits(opt.DigitBits);
+    if (n < 2) return;
+    KeyCodec<T, Key> kc{ key };
+    std::vector<T> buf(std::make_move_iterator(a), std::make_move_iterator(a + n));
+    T* src = buf.data();
+    T* dst = a;
+    LsdFields<KeyCodec<T, Key>::N - 1>(src, dst, n, kc, opt);
+    if (src != a) std::move(src, src + n, a);
+}
+
+/* ---------- MSD на месте ---------- */
+// разряд k (считая от младшего) поля I; после последнего разряда — следующее поле
+template<size_t I, typename T, typename Key>
+void MsdDigit(T* b, T* e, int k, const KeyCodec<T, Key>& kc, unsigned r) {
+    using U = typename KeyCodec<T, Key>::template U<I>;
+    const size_t R = size_t(1) << r, n = static_cast<size_t>(e - b);
+    const U mask = U(R - 1);
+    auto less = [&kc](const T& x, const T& y) { return kc.Less(x, y); };
+    for (;;) {
+        if (static_cast<size_t>(e - b) < kMsdCutoff) { sorting::PdqSort(b, e, less); return; }
+        if (k < 0) {
+            if constexpr (I + 1 < KeyCodec<T, Key>::N) {
+                using V = typename KeyCodec<T, Key>::template U<I + 1>;
+                MsdDigit<I + 1>(b, e, int((sizeof(V) * 8 + r - 1) / r) - 1, kc, r);
+            }
+            return;
+        }
+        auto digit = [&](const T& v) { return static_cast<size_t>((kc.template Field<I>(v) >> (k * r)) & mask); };
+        std::vector<size_t> cnt(R, 0);
+        for (T* p = b; p < e; ++p) ++cnt[digit(*p)];
+        if (cnt[digit(*b)] == n) { --k; continue; }          // разряд у всех одинаковый
+
+        // American flag: каждый элемент переставляется сразу в свою корзину
+        std::vector<size_t> next(R);
+        for (size_t d = 0, at = 0; d < R; ++d) { next[d] = at; at += cnt[d]; }
+        for (size_t d = 0, end = 0; d < R; ++d) {
+            end += cnt[d];
+            while (next[d] < end) {
+                size_t dd = digit(b[next[d]]);
+                if (dd == d) ++next[d];
+                else { using std::swap; swap(b[next[d]], b[next[dd]++]); }
+            }
+        }
+        for (size_t d = 0, at = 0; d < R; at += cnt[d], ++d)
+            if (cnt[d] > 1) MsdDigit<I>(b + at, b + at + cnt[d], k - 1, kc, r);
+        return;
+    }
+}
+
+template<typename T, typename Key>
+void MsdSort(T* a, size_t n, Key& key, const RadixOptions& opt) {
+    CheckDigits(opt.DigitBits);
+    if (n < 2) return;
+    KeyCodec<T, Key> kc{ key };
+    using U = typename KeyCodec<T, Key>::template U<0>;
+    const unsigned r = opt.DigitBits;
+    MsdDigit<0>(a, a + n, int((sizeof(U) * 8 + r - 1) / r) - 1, kc, r);
+}
+
+// ключ по умолчанию — сам элемент
+struct Identity {
+    template<typename T> const T& operator()(const T& v) const { return v; }
+};
+
+} // namespace radix
+
+/* ---------- массивы ---------- */
+template<typename T, typename G, typename B, typename Key = radix::Identity>
+void RadixSort(DynamicArray<T,G,B>& a, Key key = Key(), RadixOptions opt = RadixOptions())
+{
+    radix::LsdSort(a.begin(), a.GetSize(), key, opt);
+}
+
+template<typename T, typename G, typename B, typename Key = radix::Identity>
+void RadixSortMsd(DynamicArray<T,G,B>& a, Key key = Key(), RadixOptions opt = RadixOptions())
+{
+    radix::MsdSort(a.begin(), a.GetSize(), key, opt);
+}
+
+/* ---------- последовательности: массивы на месте, прочие — через временный массив ---------- */
+template<typename T, typename Key = radix::Identity>
+void RadixSort(Sequence<T>& s, Key key = Key(), RadixOptions opt = RadixOptions())
+{
+    detail::SortInPlace(s, [&](T* b, T* e) { radix::LsdSort(b, static_cast<size_t>(e - b), key, opt); });
+}
+
+template<typename T, typename Key = radix::Identity>
+void RadixSortMsd(Sequence<T>& s, Key key = Key(), RadixOptions opt = RadixOptions())
+{
+    detail::SortInPlace(s, [&](T* b, T* e) { radix::MsdSort(b, static_cast<size_t>(e - b), key, opt); });
+}
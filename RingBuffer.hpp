@@ -0,0 +1,205 @@
+#pragma once
+#include "BoundsCheck.hpp"
+#include "ChunkCursor.hpp"
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+/* Кольцевой буфер: ёмкость — степень двойки, индекс = (head_+i) & mask.
+   O(1) push/pop с обоих концов и произвольный доступ.
+   Хранилище — сырая память, как у DynamicArray: сконструированы только
+   логические [0, size_), снятый элемент разрушается сразу. */
+template<typename T>
+class RingBuffer {
+    size_t head_     = 0;   // физический индекс первого элемента
+    size_t size_     = 0;
+    size_t capacity_ = 0;   // 0 или степень двойки
+    T*     data_     = nullptr;
+
+    static T*   allocate(size_t n)        { return n ? std::allocator<T>().allocate(n) : nullptr; }
+    static void deallocate(T* p,size_t n) { if(p) std::allocator<T>().deallocate(p, n); }
+
+    size_t mask() const { return capacity_-1; }
+    size_t phys(size_t i) const { return (head_+i) & mask(); }
+    T* slot(size_t i) const { return data_+phys(i); }
+
+    void check(size_t i) const { if (i >= size_) detail::ThrowIndexOutOfRange(i, size_); }
+    void grow(){ Reserve(capacity_ ? capacity_*2 : 8); }
+    // при росте аргументы могут ссылаться на элемент этого же кольца — строим до переезда
+    template<typename... A>
+    T& emplaceBack(A&&... a){
+        if(size_==capacity_){
+            T tmp(std::forward<A>(a)...);
+            grow();
+            ::new (static_cast<void*>(slot(size_))) T(std::move(tmp));
+        } else {
+            ::new (static_cast<void*>(slot(size_))) T(std::forward<A>(a)...);
+        }
+        return *slot(size_++);
+    }
+    template<typename... A>
+    T& emplaceFront(A&&... a){
+        if(size_==capacity_){
+            T tmp(std::forward<A>(a)...);
+            grow();
+            ::new (static_cast<void*>(data_+((head_-1) & mask()))) T(std::move(tmp));
+        } else {
+            ::new (static_cast<void*>(data_+((head_-1) & mask()))) T(std::forward<A>(a)...);
+        }
+        head_ = (head_-1) & mask(); ++size_;
+        return data_[head_];
+    }
+    // сдвиг портит элементы кольца — аргумент сначала в tmp
+    template<typename U>
+    void insertAt(U&& v,size_t i){
+        if(i>size_) throw std::out_of_range("InsertAt: idx="+std::to_string(i));
+        T tmp(std::forward<U>(v));
+        if(size_==capacity_) grow();
+        if(i==size_){
+            ::new (static_cast<void*>(slot(size_))) T(std::move(tmp));
+        } else if(i==0){
+            head_ = (head_-1) & mask();
+            ::new (static_cast<void*>(slot(0))) T(std::move(tmp));
+        } else if(i < size_/2){
+            head_ = (head_-1) & mask();                 // новая ячейка слева сырая
+            ::new (static_cast<void*>(slot(0))) T(std::move(*slot(1)));
+            for(size_t k=1;k<i;++k) *slot(k) = std::move(*slot(k+1));
+            *slot(i) = std::move(tmp);
+        } else {
+            ::new (static_cast<void*>(slot(size_))) T(std::move(*slot(size_-1)));
+            for(size_t k=size_-1;k>i;--k) *slot(k) = std::move(*slot(k-1));
+            *slot(i) = std::move(tmp);
+        }
+        ++size_;
+    }
+
+public:
+    /* --- ctors --- */
+    RingBuffer() = default;
+    RingBuffer(const T* src,size_t n){
+        Reserve(n);
+        std::uninitialized_copy(src, src+n, data_);
+        size_ = n;
+    }
+
+    RingBuffer(const RingBuffer& o){
+        Reserve(o.size_);
+        for(; size_<o.size_; ++size_) ::new (static_cast<void*>(data_+size_)) T(*o.slot(size_));
+    }
+    RingBuffer& operator=(RingBuffer rhs){ swap(rhs); return *this; }
+
+    RingBuffer(RingBuffer&& o) noexcept { swap(o); }
+
+    ~RingBuffer(){
+        for(size_t i=0;i<size_;++i) slot(i)->~T();
+        deallocate(data_, capacity_);
+    }
+
+    /* --- access --- */
+    size_t GetSize()     const { return size_; }
+    size_t GetCapacity() const { return capacity_; }
+
+    T&       operator[](size_t i)       { check(i); return *slot(i); }
+    const T& operator[](size_t i) const { check(i); return *slot(i); }
+
+    /* --- блочный обход: не больше двух кусков (до и после заворота) --- */
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const {
+        if(c.pos>=size_) return false;
+        size_t at = phys(c.pos);
+        p = data_+at; n = std::min(size_-c.pos, capacity_-at);
+        c.pos += n;
+        return true;
+    }
+
+    /* --- capacity: при росте кольцо разворачивается в [0, size_) --- */
+    void Reserve(size_t n){
+        if(n<=capacity_) return;
+        size_t cap = 1; while(cap<n) cap <<= 1;
+        T* tmp = allocate(cap);
+        for(size_t i=0;i<size_;++i){
+            ::new (static_cast<void*>(tmp+i)) T(std::move_if_noexcept(*slot(i)));
+            slot(i)->~T();
+        }
+        deallocate(data_, capacity_);
+        data_ = tmp; capacity_ = cap; head_ = 0;
+    }
+
+    /* --- ends --- */
+    void PushBack(const T& v){ emplaceBack(v); }
+    void PushBack(T&& v)     { emplaceBack(std::move(v)); }
+    void PushFront(const T& v){ emplaceFront(v); }
+    void PushFront(T&& v)     { emplaceFront(std::move(v)); }
+    template<typename... A> void EmplaceBack (A&&... a) { emplaceBack(std::forward<A>(a)...); }
+    template<typename... A> void EmplaceFront(A&&... a) { emplaceFront(std::forward<A>(a)...); }
+    T PopBack(){
+        if(!size_) throw std::out_of_range("PopBack: empty ring");
+        T* p = slot(size_-1);
+        T v = std::move(*p);
+        p->~T(); --size_;
+        return v;
+    }
+    T PopFront(){
+        if(!size_) throw std::out_of_range("PopFront: empty ring");
+        T v = std::move(data_[head_]);
+        data_[head_].~T();
+        head_ = (head_+1) & mask(); --size_;
+        return v;
+    }
+
+    /* --- середина: сдвигаем более короткую сторону --- */
+    void InsertAt(const T& v,size_t i){ insertAt(v, i); }
+    void InsertAt(T&& v,size_t i)     { insertAt(std::move(v), i); }
+    T RemoveAt(size_t i){
+        check(i);
+        T v = std::move(*slot(i));
+        if(i < size_/2){
+            for(size_t k=i;k>0;--k) *slot(k) = std::move(*slot(k-1));
+            slot(0)->~T();
+            head_ = (head_+1) & mask();
+        } else {
+            for(size_t k=i;k+1<size_;++k) *slot(k) = std::move(*slot(k+1));
+            slot(size_-1)->~T();
+        }
+        --size_;
+        return v;
+    }
+    void Erase(size_t l,size_t r){          // [l, r]
+        if(l>r || r>=size_) throw std::out_of_range("Erase: bad range");
+        size_t cnt = r-l+1;
+        if(l < size_-r-1){
+            for(size_t k=l;k>0;--k) *slot(k-1+cnt) = std::move(*slot(k-1));
+            for(size_t k=0;k<cnt;++k) slot(k)->~T();
+            head_ = (head_+cnt) & mask();
+        } else {
+            for(size_t k=r+1;k<size_;++k) *slot(k-cnt) = std::move(*slot(k));
+            for(size_t k=size_-cnt;k<size_;++k) slot(k)->~T();
+        }
+        size_ -= cnt;
+    }
+
+    /* --- simple iterators --- */
+    template<typename R, typename Owner>
+    class iter{
+        Owner* o; size_t i;
+    public:
+        iter(Owner* own,size_t idx):o(own),i(idx){}
+        iter& operator++(){ ++i; return *this; }
+        bool operator!=(const iter& x)const{ return i!=x.i; }
+        R& operator*() const { return *o->slot(i); }
+    };
+    using it  = iter<T, RingBuffer>;
+    using cit = iter<const T, const RingBuffer>;
+
+    it  begin(){ return it(this,0); }        it  end(){ return it(this,size_); }
+    cit begin() const { return cit(this,0); } cit end() const { return cit(this,size_); }
+
+    /* --- util --- */
+    void swap(RingBuffer& o) noexcept {
+        std::swap(head_, o.head_);
+        std::swap(size_, o.size_);
+        std::swap(capacity_, o.capacity_);
+        std::swap(data_, o.data_);
+    }
+};
@@ -0,0 +1,200 @@
+#pragma once
+#include "BoundsCheck.hpp"
+#include "ChunkCursor.hpp"
+#include "DynamicArray.hpp"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Rope: AVL-сбалансированное дерево, листья — непрерывные куски до kLeaf
+   элементов, внутренний узел хранит размер поддерева. Узлы неизменяемы и
+   разделяются (shared_ptr): копия — O(1), изменения копируют путь.
+   Get / InsertAt / RemoveAt — O(log n) (+ O(kLeaf) на копию листа),
+   Concat / Split / Erase / Splice — O(log n) без копирования элементов. */
+template<typename T>
+class Rope {
+public:
+    static constexpr size_t kLeaf = std::max<size_t>(16, 512 / sizeof(T));
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+    struct Node {
+        size_t size = 0;
+        int    height = 0;                  // 0 — лист
+        NodePtr left, right;
+        DynamicArray<T> items;              // только у листа
+    };
+
+    NodePtr root_;
+
+    static size_t sizeOf(const NodePtr& n) { return n ? n->size : 0; }
+    static int    heightOf(const NodePtr& n) { return n ? n->height : -1; }
+
+    static NodePtr leaf(DynamicArray<T>&& items) {
+        auto n = std::make_shared<Node>();
+        n->size = items.GetSize();
+        n->items = std::move(items);
+        return n;
+    }
+    static NodePtr leaf(const T* p, size_t k) { return leaf(DynamicArray<T>(p, k)); }
+    static NodePtr inner(NodePtr l, NodePtr r) {
+        auto n = std::make_shared<Node>();
+        n->size = l->size + r->size;
+        n->height = std::max(l->height, r->height) + 1;
+        n->left = std::move(l); n->right = std::move(r);
+        return n;
+    }
+    // высоты l и r отличаются не больше чем на 2
+    static NodePtr rebalance(NodePtr l, NodePtr r) {
+        if (heightOf(l) > heightOf(r) + 1) {
+            if (heightOf(l->left) >= heightOf(l->right)) return inner(l->left, inner(l->right, std::move(r)));
+            return inner(inner(l->left, l->right->left), inner(l->right->right, std::move(r)));
+        }
+        if (heightOf(r) > heightOf(l) + 1) {
+            if (heightOf(r->right) >= heightOf(r->left)) return inner(inner(std::move(l), r->left), r->right);
+            return inner(inner(std::move(l), r->left->left), inner(r->left->right, r->right));
+        }
+        return inner(std::move(l), std::move(r));
+    }
+    // конкатенация за O(|h(l) - h(r)|); мелкие соседние листья сливаются
+    static NodePtr join(NodePtr l, NodePtr r) {
+        if (!l) return r;
+        if (!r) return l;
+        if (!l->height && !r->height && l->size + r->size <= kLeaf) {
+            DynamicArray<T> items(l->items);
+            items.Reserve(l->size + r->size);
+            for (const T& v : r->items) items.PushBack(v);
+            return leaf(std::move(items));
+        }
+        if (l->height > r->height + 1) return rebalance(l->left, join(l->right, std::move(r)));
+        if (r->height > l->height + 1) return rebalance(join(std::move(l), r->left), r->right);
+        return inner(std::move(l), std::move(r));
+    }
+    // {первые i элементов, остальное}
+    static std::pair<NodePtr, NodePtr> split(const NodePtr& n, size_t i) {
+        if (!n) return { nullptr, nullptr };
+        if (i == 0) return { nullptr, n };
+        if (i >= n->size) return { n, nullptr };
+        if (!n->height) return { leaf(n->items.begin(), i), leaf(n->items.begin() + i, n->size - i) };
+        size_t ls = n->left->size;
+        if (i == ls) return { n->left, n->right };
+        if (i < ls) {
+            auto [a, b] = split(n->left, i);
+            return { std::move(a), join(std::move(b), n->right) };
+        }
+        auto [a, b] = split(n->right, i - ls);
+        return { join(n->left, std::move(a)), std::move(b) };
+    }
+    static NodePtr insert(const NodePtr& n, size_t i, const T& v) {
+        if (!n) { DynamicArray<T> d; d.PushBack(v); return leaf(std::move(d)); }
+        if (!n->height) {
+            DynamicArray<T> items;
+            items.Reserve(n->size + 1);
+            for (size_t k = 0; k < i; ++k) items.PushBack(n->items[k]);
+            items.PushBack(v);
+            for (size_t k = i; k < n->size; ++k) items.PushBack(n->items[k]);
+            if (items.GetSize() <= kLeaf) return leaf(std::move(items));
+            size_t h = items.GetSize() / 2;          // полный лист делится пополам
+            return inner(leaf(items.begin(), h), leaf(items.begin() + h, items.GetSize() - h));
+        }
+        size_t ls = n->left->size;
+        if (i <= ls) return rebalance(insert(n->left, i, v), n->right);
+        return rebalance(n->left, insert(n->right, i - ls, v));
+    }
+    static NodePtr erase(const NodePtr& n, size_t i) {
+        if (!n->height) {
+            if (n->size == 1) return nullptr;
+            DynamicArray<T> items(n->items);
+            items.RemoveAt(i);
+            return leaf(std::move(items));
+        }
+        size_t ls = n->left->size;
+        if (i < ls) return join(erase(n->left, i), n->right);
+        return join(n->left, erase(n->right, i - ls));
+    }
+    // сбалансированное дерево из готовых листьев за O(n)
+    static NodePtr build(const std::vector<NodePtr>& leaves, size_t lo, size_t hi) {
+        if (hi - lo == 1) return leaves[lo];
+        size_t mid = lo + (hi - lo) / 2;
+        return inner(build(leaves, lo, mid), build(leaves, mid, hi));
+    }
+    const Node* leafAt(size_t& i) const {       // i становится смещением в листе
+        const Node* n = root_.get();
+        while (n->height) {
+            if (i < n->left->size) n = n->left.get();
+            else { i -= n->left->size; n = n->right.get(); }
+        }
+        return n;
+    }
+    void range_check(size_t i) const { if (i >= GetSize()) detail::ThrowIndexOutOfRange(i, GetSize()); }
+    explicit Rope(NodePtr r): root_(std::move(r)) {}
+
+public:
+    Rope() = default;
+    Rope(const T* p, size_t n) {
+        if (!n) return;
+        std::vector<NodePtr> leaves;
+        for (size_t i = 0; i < n; i += kLeaf) leaves.push_back(leaf(p + i, std::min(kLeaf, n - i)));
+        root_ = build(leaves, 0, leaves.size());
+    }
+
+    size_t GetSize() const { return sizeOf(root_); }
+    int    Height()  const { return heightOf(root_); }
+
+    const T& operator[](size_t i) const { range_check(i); const Node* l = leafAt(i); return l->items[i]; }
+
+    /* --- изменения (копия пути; другие копии Rope не затрагиваются) --- */
+    void InsertAt(const T& v, size_t i) {
+        if (i > GetSize()) throw std::out_of_range("InsertAt: bad idx");
+        root_ = insert(root_, i, v);
+    }
+    void PushBack(const T& v)  { root_ = insert(root_, GetSize(), v); }
+    void PushFront(const T& v) { root_ = insert(root_, 0, v); }
+    T RemoveAt(size_t i) {
+        range_check(i);
+        T v = (*this)[i];
+        root_ = erase(root_, i);
+        return v;
+    }
+    void Erase(size_t l, size_t r) {            // [l, r]
+        if (l > r || r >= GetSize()) throw std::out_of_range("Erase: bad range");
+        auto [a, rest] = split(root_, l);
+        auto [mid, c]  = split(rest, r - l + 1);
+        root_ = join(std::move(a), std::move(c));
+    }
+    void Append(const Rope& o) { root_ = join(root_, o.root_); }
+    void Prepend(const Rope& o) { root_ = join(o.root_, root_); }
+
+    /* --- новые верёвки без копирования элементов --- */
+    Rope Split(size_t i) {                      // в this остаются первые i, возвращается хвост
+        if (i > GetSize()) throw std::out_of_range("Split: bad idx");
+        auto [a, b] = split(root_, i);
+        root_ = std::move(a);
+        return Rope(std::move(b));
+    }
+    Rope SubRope(size_t l, size_t cnt) const {  // [l, l+cnt)
+        if (l + cnt > GetSize()) throw std::out_of_range("SubRope: bad range");
+        return Rope(split(split(root_, l).second, cnt).first);
+    }
+    // [start, start+cnt) заменяется на repl
+    Rope Splice(size_t start, size_t cnt, const Rope& repl) const {
+        if (start + cnt > GetSize()) throw std::out_of_range("Splice: bad range");
+        auto [a, rest] = split(root_, start);
+        return Rope(join(join(std::move(a), repl.root_), split(rest, cnt).second));
+    }
+
+    /* блочный обход: лист за раз, курсор — индекс следующего элемента */
+    bool NextChunk(ChunkCursor& c, const T*& p, size_t& n) const {
+        if (c.pos >= GetSize()) return false;
+        size_t off = c.pos;
+        const Node* l = leafAt(off);
+        p = l->items.begin() + off;
+        n = l->size - off;
+        c.pos += n;
+        return true;
+    }
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include "Sequence.hpp"
+#include "Rope.hpp"
+#include <stdexcept>
+#include <string>
+
+/* Последовательность на Rope: Get/InsertAt/RemoveAt — O(log n),
+   Concat с другой RopeSequence, GetSubsequence, EraseRange и Splice — O(log n)
+   без копирования элементов. Узлы общие, поэтому Clone и immutable-операции
+   тоже дешёвые: копия верёвки O(1) плюс копия пути. */
+template<typename T>
+class RopeSequence : public Sequence<T> {
+    Rope<T> rope_;
+
+    // правый операнд Concat: свой Rope без копии или сборка за O(m)
+    static Rope<T> asRope(const Sequence<T>* o) {
+        if (auto* r = dynamic_cast<const RopeSequence*>(o)) return r->rope_;
+        DynamicArray<T> tmp;
+        tmp.Reserve(o->GetLength());
+        o->ForEach([&](const T& v) { tmp.PushBack(v); });
+        return Rope<T>(tmp.begin(), tmp.GetSize());
+    }
+public:
+    RopeSequence() = default;
+    RopeSequence(const T* p,size_t n): rope_(p,n) {}
+    explicit RopeSequence(Rope<T> r): rope_(std::move(r)) {}
+
+    const Rope<T>& GetRope() const { return rope_; }
+
+    /* read */
+    size_t GetLength()               const override { return rope_.GetSize(); }
+    const T& Get(size_t i)           const override { return rope_[i]; }
+    const T& GetFirst()              const override {
+        if (!GetLength()) throw std::out_of_range("empty");
+        return Get(0);
+    }
+    const T& GetLast()               const override {
+        if (!GetLength()) throw std::out_of_range("empty");
+        return Get(GetLength()-1);
+    }
+
+    /* mutable */
+    void Append (const T& v) override { rope_.PushBack(v); }
+    void Prepend(const T& v) override { rope_.PushFront(v); }
+    void InsertAt(const T& v,size_t idx) override { rope_.InsertAt(v, idx); }
+    Sequence<T>* Concat(Sequence<T>* other) override { rope_.Append(asRope(other)); return this; }
+    T PopBack()  override {
+        if (!GetLength()) throw std::out_of_range("PopBack: empty");
+        return rope_.RemoveAt(GetLength()-1);
+    }
+    T PopFront() override {
+        if (!GetLength()) throw std::out_of_range("PopFront: empty");
+        return rope_.RemoveAt(0);
+    }
+    T RemoveAt(size_t idx) override { return rope_.RemoveAt(idx); }
+    void EraseRange(size_t l,size_t r) override { rope_.Erase(l,r); }
+
+    // [start, start+cnt) заменяется на repl (nullptr — просто удаление)
+    void Splice(size_t start,size_t cnt,const Sequence<T>* repl=nullptr) {
+        rope_ = rope_.Splice(start, cnt, repl ? asRope(repl) : Rope<T>());
+    }
+    // в this остаются первые i элементов, хвост возвращается
+    SeqUPtr<T> SplitAt(size_t i) { return SeqUPtr<T>(new RopeSequence(rope_.Split(i))); }
+
+    /* immutable — O(1) копия верёвки + изменение */
+    SeqUPtr<T> Append(const T& v) const override {
+        auto cp = std::make_unique<RopeSequence>(*this);
+        cp->rope_.PushBack(v); return cp;
+    }
+    SeqUPtr<T> Prepend(const T& v) const override {
+        auto cp = std::make_unique<RopeSequence>(*this);
+        cp->rope_.PushFront(v); return cp;
+    }
+    SeqUPtr<T> InsertAt(const T& v,size_t i) const override {
+        auto cp = std::make_unique<RopeSequence>(*this);
+        cp->rope_.InsertAt(v,i); return cp;
+    }
+    SeqUPtr<T> Concat(const Sequence<T>* o) const override {
+        auto cp = std::make_unique<RopeSequence>(*this);
+        cp->rope_.Append(asRope(o)); return cp;
+    }
+
+    /* service */
+    SeqUPtr<T> GetSubsequence(size_t l,size_t r) const override {
+        if (l>r || r>=GetLength()) throw std::out_of_range("subseq: bad range");
+        return SeqUPtr<T>(new RopeSequence(rope_.SubRope(l, r-l+1)));
+    }
+    SeqUPtr<T> Clone() const override { return SeqUPtr<T>(new RopeSequence(*this)); }
+    Sequence<T>* Instance() override { return this; }
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const override {
+        return rope_.NextChunk(c,p,n);
+    }
+};
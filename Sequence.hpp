@@ -1,15 +1,35 @@
 #pragma once
+#include "BoundsCheck.hpp"
+#include "ChunkCursor.hpp"
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 template<typename T> class Sequence;
-template<typename T> class MutableArraySequence;
+template<typename T, typename Bounds = CheckedBounds> class MutableArraySequence;
+template<typename Stage> class SeqView;
+namespace view { template<typename T> struct Source; }
 
 template<typename T>
 using SeqUPtr = std::unique_ptr< Sequence<T> >;
 
+namespace detail {
+    /* Копирующие пути, которые виртуальный API Sequence<T> инстанцирует для любого T
+       (Append(const T&), Concat, копия общего буфера), — только через CopyingPath.
+       f вызывается от x и должна быть шаблоном (auto-параметр): для move-only T
+       (SeqUPtr в классическом Split) её тело не инстанцируется, вызов бросает.
+       Хранилища (DynamicArray::EmplaceBack, InsertRange, ...) остаются строгими. */
+    template<typename T, typename R = void, typename X, typename F>
+    R CopyingPath(X&& x, F&& f) {
+        if constexpr (std::is_copy_constructible_v<T>) return std::forward<F>(f)(std::forward<X>(x));
+        else throw std::logic_error("Sequence: copy of move-only element");
+    }
+}
+
 template<typename T>
 class Sequence {
 public:
@@ -18,8 +38,8 @@ public:
     /* --- обязательный API --- */
     virtual size_t    GetLength() const                       = 0;
     virtual const T&  Get(size_t) const                       = 0;
-    virtual T         GetFirst() const                        = 0;
-    virtual T         GetLast()  const                        = 0;
+    virtual const T&  GetFirst() const                        = 0;
+    virtual const T&  GetLast()  const                        = 0;
 
     virtual SeqUPtr<T> GetSubsequence(size_t, size_t) const   = 0;
     virtual SeqUPtr<T> Clone() const                          = 0;
@@ -36,43 +56,84 @@ public:
     virtual void InsertAt(const T&, size_t)                   = 0;
     virtual Sequence<T>* Concat(Sequence<T>*)                 = 0;
 
+    /* mutable-операции с переносом элемента; по умолчанию — копия,
+       хранилища с move-вставкой их переопределяют */
+    virtual void Append (T&& v)            { Append(static_cast<const T&>(v)); }
+    virtual void Prepend(T&& v)            { Prepend(static_cast<const T&>(v)); }
+    virtual void InsertAt(T&& v, size_t i) { InsertAt(static_cast<const T&>(v), i); }
+
+    /* элемент строится из аргументов и переносится в хранилище */
+    template<typename... A> void EmplaceBack (A&&... a)         { Append(T(std::forward<A>(a)...)); }
+    template<typename... A> void EmplaceFront(A&&... a)         { Prepend(T(std::forward<A>(a)...)); }
+    template<typename... A> void EmplaceAt(size_t i, A&&... a)  { InsertAt(T(std::forward<A>(a)...), i); }
+
+    /* удаление (mutable), элемент возвращается move-ом; границы [l, r] */
+    virtual T    PopBack()                                    = 0;
+    virtual T    PopFront()                                   = 0;
+    virtual T    RemoveAt(size_t)                             = 0;
+    virtual void EraseRange(size_t, size_t)                   = 0;
+
     /* фабрика (нужна flatMap и т.п.) */
     virtual Sequence<T>* Instance()                           = 0;
 
-    /* --- util-алгоритмы --- */
+    /* блочный обход: следующий непрерывный кусок [p, p+n) после курсора;
+       false — элементы кончились. Один виртуальный вызов на кусок */
+    virtual bool NextChunk(ChunkCursor&, const T*&, size_t&) const = 0;
+
+    /* f(const T* p, size_t n) -> bool; false останавливает обход */
+    template<typename F>
+    bool ForEachChunk(F f) const {
+        ChunkCursor c; const T* p; size_t n;
+        while (NextChunk(c, p, n)) if (!f(p, n)) return false;
+        return true;
+    }
+    template<typename F>
+    void ForEach(F f) const {
+        ForEachChunk([&](const T* p, size_t n) {
+            for (size_t i=0;i<n;++i) f(p[i]);
+            return true;
+        });
+    }
+
+    /* --- util-алгоритмы (поверх ForEachChunk, O(n) для любого хранилища) --- */
     template<typename U, typename F>
     SeqUPtr<U> Map(F f) const {
         auto out = SeqUPtr<U>(new MutableArraySequence<U>());
-        for (size_t i=0;i<GetLength();++i) out->Append(f(Get(i)));
+        ForEach([&](const T& v) { out->Append(f(v)); });
         return out;
     }
     template<typename U, typename R>
     U Reduce(U init, R r) const {
-        for (size_t i=0;i<GetLength();++i) init = r(init, Get(i));
+        ForEach([&](const T& v) { init = r(init, v); });
         return init;
     }
     template<typename P>
     SeqUPtr<T> Where(P p) const {
         auto out = SeqUPtr<T>(new MutableArraySequence<T>());
-        for (size_t i=0;i<GetLength();++i) if (p(Get(i))) out->Append(Get(i));
+        ForEach([&](const T& v) { if (p(v)) out->Append(v); });
         return out;
     }
 
-    /* FlatMap */
-    template<typename U, typename F>
+    /* FlatMap; Out — тип результата (например, SmallArraySequence<U,N>) */
+    template<typename U, typename Out = MutableArraySequence<U>, typename F>
     SeqUPtr<U> FlatMap(F f) const {
-        auto out = SeqUPtr<U>(new MutableArraySequence<U>());
-        for (size_t i=0;i<GetLength();++i) {
-            auto sub = f(Get(i));
-            for (size_t j=0;j<sub->GetLength();++j) out->Append(sub->Get(j));
-        }
+        auto out = SeqUPtr<U>(new Out());
+        ForEach([&](const T& v) {
+            auto sub = f(v);
+            sub->ForEach([&](const U& u) { out->Append(u); });
+        });
         return out;
     }
 
     /* Try-семантика */
     template<typename P>
     std::optional<T> TryFirst(P p) const {
-        for (size_t i=0;i<GetLength();++i) if (p(Get(i))) return Get(i);
+        const T* hit = nullptr;
+        ForEachChunk([&](const T* q, size_t n) {
+            for (size_t i=0;i<n;++i) if (p(q[i])) { hit = q+i; return false; }
+            return true;
+        });
+        if (hit) return *hit;
         return std::nullopt;
     }
     template<typename P>
@@ -81,16 +142,28 @@ public:
         throw std::out_of_range("Find: no match");
     }
 
-    /* итератор-обёртка */
+    /* ленивый конвейер без промежуточных последовательностей (SequenceView.hpp) */
+    SeqView< view::Source<T> > View() const { return SeqView< view::Source<T> >(view::Source<T>{ this }); }
+
+    /* итератор-обёртка: идёт по кускам NextChunk */
     class Iterator {
         const Sequence<T>* seq_;
         size_t idx_;
+        ChunkCursor cur_;
+        const T* p_ = nullptr;
+        size_t left_ = 0;               // сколько осталось в текущем куске
+        void fetch() { if (!seq_->NextChunk(cur_, p_, left_)) left_ = 0; }
     public:
         using iterator_category = std::forward_iterator_tag;
-        Iterator(const Sequence<T>* s,size_t i): seq_(s), idx_(i) {}
-        Iterator& operator++(){ ++idx_; return *this; }
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+        Iterator(const Sequence<T>* s,size_t i): seq_(s), idx_(i) { if (i == 0) fetch(); }
+        Iterator& operator++(){ ++idx_; ++p_; if (--left_ == 0) fetch(); return *this; }
         bool operator!=(const Iterator& o) const { return idx_ != o.idx_; }
-        const T& operator*() const { return seq_->Get(idx_); }
+        bool operator==(const Iterator& o) const { return idx_ == o.idx_; }
+        const T& operator*() const { return *p_; }
     };
     Iterator begin() const { return Iterator(this,0); }
     Iterator end()   const { return Iterator(this,GetLength()); }
@@ -98,3 +171,5 @@ public:
     /* удобный [] */
     const T& operator[](size_t i) const { return Get(i); }
 };
+
+#include "SequenceView.hpp"
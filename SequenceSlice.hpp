@@ -0,0 +1,196 @@
+#pragma once
+#include "BoundsCheck.hpp"
+#include "Sequence.hpp"
+#include "DynamicArray.hpp"
+#include "Stats.hpp"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/* DynamicArray под счётчиком ссылок с копированием при записи.
+   Хранилище Mutable/ImmutableArraySequence: копия последовательности и
+   срезы SequenceSlice делят буфер, пока кто-то из них не начнёт его менять.
+   Как и у std::shared_ptr, Write() из нескольких потоков над одним
+   объектом требует внешней синхронизации.
+   Массив над файлом (DynamicArray::Mapped) изменяемые последовательности не
+   делят: иначе при записи от файла отцепился бы сам владелец. Копия владельца
+   (ForOwner) и изменяемый срез получают свою копию в куче. */
+template<typename T>
+class SharedArray {
+    std::shared_ptr<DynamicArray<T>> p_;    // nullptr — пустой массив, буфер заводится при первой записи
+
+    static const DynamicArray<T>& empty() { static const DynamicArray<T> e; return e; }
+    // копия n элементов в свой буфер (detail::CopyingPath: для move-only T бросает)
+    static std::shared_ptr<DynamicArray<T>> copy(const T* p,size_t n) {
+        return detail::CopyingPath<T, std::shared_ptr<DynamicArray<T>>>(p, [n](auto src) {
+            return std::make_shared<DynamicArray<T>>(src, n);
+        });
+    }
+public:
+    SharedArray() = default;
+    SharedArray(const T* p,size_t n): p_(copy(p,n)) {}
+    explicit SharedArray(DynamicArray<T>&& d): p_(std::make_shared<DynamicArray<T>>(std::move(d))) {}
+    explicit SharedArray(std::shared_ptr<DynamicArray<T>> p): p_(std::move(p)) {}
+
+    const DynamicArray<T>& Read() const { return p_ ? *p_ : empty(); }
+    DynamicArray<T>& Write() {
+        if (!p_) p_ = std::make_shared<DynamicArray<T>>();
+        else if (p_.use_count() > 1) p_ = copy(p_->data(), p_->GetSize());
+        return *p_;
+    }
+    const std::shared_ptr<DynamicArray<T>>& Share() const { return p_; }
+    bool IsShared() const { return p_.use_count() > 1; }
+    bool IsMapped() const { return p_ && p_->IsMapped(); }
+    // буфер для ещё одного изменяемого владельца: общий, а файловый — копией
+    SharedArray ForOwner() const { return IsMapped() ? SharedArray(Read().data(), Read().GetSize()) : *this; }
+};
+
+/* Срез [off, off+len) чужого буфера за O(1): держит буфер живым через
+   SharedArray, сам ничего не копирует. При первом изменении (mutable-операции)
+   копирует только свой диапазон и дальше ведёт себя как MutableArraySequence.
+   Immutable-операции возвращают новый срез поверх копии. Срез immutable-
+   последовательности (readOnly) на mutable-операции бросает, как и она сама.
+   Изменяемый срез массива над файлом сразу копирует свой диапазон (SharedArray).
+   С -DSEQ_STATS Stats() считает эти копии диапазона. */
+template<typename T>
+class SequenceSlice : public Sequence<T>, protected stats::Counters<stats::SequenceKind> {
+    SharedArray<T> buf_;
+    size_t off_ = 0, len_ = 0;
+    bool readOnly_ = false;
+
+    const T* ptr() const { return buf_.Read().begin() + off_; }
+    // свой буфер ровно под срез
+    DynamicArray<T>& own() {
+        if (readOnly_) throw std::logic_error("immutable");
+        if (buf_.IsShared() || off_ != 0 || len_ != buf_.Read().GetSize()) {
+            stats::CountCopy<T>(*this, len_);
+            buf_ = SharedArray<T>(ptr(), len_);
+            off_ = 0;
+        }
+        return buf_.Write();
+    }
+    void range_check(size_t i) const { if (i >= len_) detail::ThrowIndexOutOfRange(i, len_); }
+    SequenceSlice detachedCopy() const { return SequenceSlice(SharedArray<T>(ptr(), len_), 0, len_, false); }
+    // копия аргумента до own(): v может лежать в буфере, который own() отпустит
+    static T copyOf(const T& v) {
+        return detail::CopyingPath<T, T>(v, [](const auto& x) { return x; });
+    }
+    template<typename U>
+    void insertAt(U&& v,size_t idx) {
+        if (readOnly_) throw std::logic_error("immutable");
+        if (idx>len_) throw std::out_of_range("InsertAt: bad idx");
+        own().Emplace(idx, std::forward<U>(v));
+        ++len_;
+    }
+public:
+    SequenceSlice() = default;
+    SequenceSlice(SharedArray<T> buf,size_t off,size_t len,bool readOnly=false)
+        : buf_(std::move(buf)), off_(off), len_(len), readOnly_(readOnly) {
+        if (off_ + len_ > buf_.Read().GetSize()) throw std::out_of_range("SequenceSlice: bad range");
+        if (!readOnly_ && buf_.IsMapped()) {
+            stats::CountCopy<T>(*this, len_);
+            buf_ = SharedArray<T>(ptr(), len_);
+            off_ = 0;
+        }
+    }
+
+    bool IsView()     const { return buf_.IsShared(); }
+    bool IsReadOnly() const { return readOnly_; }
+    const SharedArray<T>& Buffer() const { return buf_; }
+    size_t Offset() const { return off_; }
+
+    /* read */
+    using stats::Counters<stats::SequenceKind>::Stats;
+    size_t GetLength()               const override { return len_; }
+    const T& Get(size_t i)           const override { range_check(i); return ptr()[i]; }
+    const T& GetUnchecked(size_t i)  const          { return ptr()[i]; }
+    const T* data()                  const          { return ptr(); }
+    T*       data()                                 { return own().data(); }   // после копии своего диапазона
+    const T& GetFirst()              const override {
+        if (!len_) throw std::out_of_range("empty");
+        return ptr()[0];
+    }
+    const T& GetLast()               const override {
+        if (!len_) throw std::out_of_range("empty");
+        return ptr()[len_-1];
+    }
+
+    /* mutable — после копии своего диапазона */
+    void Append (const T& v) override { T x(copyOf(v)); own().PushBack(std::move(x)); ++len_; }
+    void Append (T&& v)      override { own().PushBack(std::move(v)); ++len_; }
+    void Prepend(const T& v) override { InsertAt(v, 0); }
+    void Prepend(T&& v)      override { InsertAt(std::move(v), 0); }
+    void InsertAt(const T& v,size_t idx) override { insertAt(copyOf(v), idx); }
+    void InsertAt(T&& v,size_t idx)      override { insertAt(std::move(v), idx); }
+    Sequence<T>* Concat(Sequence<T>* other) override {
+        detail::CopyingPath<T>(other, [this](auto* o) {
+            size_t left = o->GetLength();           // other может оказаться нами самими
+            auto& d = own();
+            d.Reserve(len_+left);
+            o->ForEachChunk([&](const T* p, size_t n) {
+                n = std::min(n, left); left -= n;
+                d.AppendRange(p, p+n);
+                return left > 0;
+            });
+            len_ = d.GetSize();
+        });
+        return this;
+    }
+    T PopBack() override {
+        if (!len_) throw std::out_of_range("PopBack: empty");
+        T v = own().PopBack(); --len_; return v;
+    }
+    T PopFront() override {
+        if (readOnly_) throw std::logic_error("immutable");
+        if (!len_) throw std::out_of_range("PopFront: empty");
+        // срез сдвигается без копирования буфера; из своего буфера элемент забирается move-ом
+        T v = buf_.IsShared() ? copyOf(ptr()[0]) : std::move(buf_.Write()[off_]);
+        ++off_; --len_;
+        return v;
+    }
+    T RemoveAt(size_t idx) override { range_check(idx); T v = own().RemoveAt(idx); --len_; return v; }
+    void EraseRange(size_t l,size_t r) override {
+        if (l>r || r>=len_) throw std::out_of_range("EraseRange: bad range");
+        own().Erase(l,r); len_ -= r-l+1;
+    }
+
+    /* immutable — копия диапазона + изменение */
+    SeqUPtr<T> Append(const T& v) const override {
+        auto cp = std::make_unique<SequenceSlice>(detachedCopy());
+        cp->Append(v); return cp;
+    }
+    SeqUPtr<T> Prepend(const T& v) const override { return InsertAt(v, 0); }
+    SeqUPtr<T> InsertAt(const T& v,size_t i) const override {
+        auto cp = std::make_unique<SequenceSlice>(detachedCopy());
+        cp->InsertAt(v,i); return cp;
+    }
+    SeqUPtr<T> Concat(const Sequence<T>* other) const override {
+        return detail::CopyingPath<T, SeqUPtr<T>>(other, [this](auto* o) {
+            DynamicArray<T> d;
+            d.Reserve(len_+o->GetLength());
+            d.AppendRange(ptr(), ptr()+len_);
+            o->ForEachChunk([&d](const T* p, size_t n) { d.AppendRange(p, p+n); return true; });
+            size_t n = d.GetSize();
+            return SeqUPtr<T>(new SequenceSlice(SharedArray<T>(std::move(d)), 0, n));
+        });
+    }
+
+    /* service */
+    SeqUPtr<T> GetSubsequence(size_t l,size_t r) const override {
+        if (l>r || r>=len_) throw std::out_of_range("subseq: bad range");
+        return SeqUPtr<T>(new SequenceSlice(buf_, off_+l, r-l+1, readOnly_));
+    }
+    SeqUPtr<T> Clone() const override { return SeqUPtr<T>(new SequenceSlice(*this)); }
+    Sequence<T>* Instance() override { return this; }
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const override {
+        if (c.pos || !len_) return false;
+        p = ptr(); n = len_; c.pos = len_;
+        return true;
+    }
+
+    const T* begin() const { return ptr(); }
+    const T* end()   const { return ptr()+len_; }
+};
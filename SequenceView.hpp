@@ -0,0 +1,165 @@
+#pragma once
+#include "Sequence.hpp"
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/* Ленивые конвейеры: seq.View().Where(p).Map(f).Take(n).Reduce(init, r).
+   Каждая стадия — тип, оборачивающий предыдущую, поэтому весь конвейер
+   собирается компилятором в один цикл по кускам NextChunk без промежуточных
+   последовательностей. Данные «проталкиваются» в sink(const V&) -> bool;
+   false останавливает обход до конца (Take, TryFirst).
+   View не владеет последовательностью — она должна жить дольше view. */
+
+namespace view {
+
+template<typename T>
+struct Source {
+    using value_type = T;
+    const Sequence<T>* seq;
+
+    template<typename Sink>
+    bool Run(Sink&& sink) const {
+        return seq->ForEachChunk([&](const T* p, size_t n) {
+            for (size_t i = 0; i < n; ++i) if (!sink(p[i])) return false;
+            return true;
+        });
+    }
+};
+
+template<typename Prev, typename P>
+struct WhereStage {
+    using value_type = typename Prev::value_type;
+    Prev prev; P pred;
+
+    template<typename Sink>
+    bool Run(Sink&& sink) const {
+        return prev.Run([&](const value_type& v) { return pred(v) ? sink(v) : true; });
+    }
+};
+
+template<typename Prev, typename F>
+struct MapStage {
+    using value_type = std::decay_t<std::invoke_result_t<const F&, const typename Prev::value_type&>>;
+    Prev prev; F f;
+
+    template<typename Sink>
+    bool Run(Sink&& sink) const {
+        return prev.Run([&](const typename Prev::value_type& v) { return sink(f(v)); });
+    }
+};
+
+template<typename S> struct SeqElement;
+template<typename U> struct SeqElement< Sequence<U> > { using type = U; };
+
+/* f(v) -> SeqUPtr<U>, как у Sequence::FlatMap */
+template<typename Prev, typename F>
+struct FlatMapStage {
+    using Result     = std::invoke_result_t<const F&, const typename Prev::value_type&>;
+    using value_type = typename SeqElement<typename Result::element_type>::type;
+    Prev prev; F f;
+
+    template<typename Sink>
+    bool Run(Sink&& sink) const {
+        return prev.Run([&](const typename Prev::value_type& v) {
+            auto sub = f(v);
+            return sub->ForEachChunk([&](const value_type* p, size_t n) {
+                for (size_t i = 0; i < n; ++i) if (!sink(p[i])) return false;
+                return true;
+            });
+        });
+    }
+};
+
+template<typename Prev>
+struct TakeStage {
+    using value_type = typename Prev::value_type;
+    Prev prev; size_t n;
+
+    template<typename Sink>
+    bool Run(Sink&& sink) const {
+        if (!n) return false;
+        size_t left = n;
+        prev.Run([&](const value_type& v) { return sink(v) && --left != 0; });
+        return false;
+    }
+};
+
+template<typename Prev>
+struct SkipStage {
+    using value_type = typename Prev::value_type;
+    Prev prev; size_t n;
+
+    template<typename Sink>
+    bool Run(Sink&& sink) const {
+        size_t skip = n;
+        return prev.Run([&](const value_type& v) {
+            if (skip) { --skip; return true; }
+            return sink(v);
+        });
+    }
+};
+
+template<typename Prev, typename P>
+struct TakeWhileStage {
+    using value_type = typename Prev::value_type;
+    Prev prev; P pred;
+
+    template<typename Sink>
+    bool Run(Sink&& sink) const {
+        prev.Run([&](const value_type& v) { return pred(v) && sink(v); });
+        return false;
+    }
+};
+
+} // namespace view
+
+template<typename Stage>
+class SeqView {
+    Stage st_;
+
+    template<typename S> static SeqView<S> wrap(S s) { return SeqView<S>(std::move(s)); }
+public:
+    using value_type = typename Stage::value_type;
+
+    explicit SeqView(Stage st): st_(std::move(st)) {}
+
+    /* --- стадии (ничего не вычисляют) --- */
+    template<typename P> auto Where(P p)     const { return wrap(view::WhereStage<Stage, P>{ st_, std::move(p) }); }
+    template<typename F> auto Map(F f)       const { return wrap(view::MapStage<Stage, F>{ st_, std::move(f) }); }
+    template<typename F> auto FlatMap(F f)   const { return wrap(view::FlatMapStage<Stage, F>{ st_, std::move(f) }); }
+    template<typename P> auto TakeWhile(P p) const { return wrap(view::TakeWhileStage<Stage, P>{ st_, std::move(p) }); }
+    auto Take(size_t n) const { return wrap(view::TakeStage<Stage>{ st_, n }); }
+    auto Skip(size_t n) const { return wrap(view::SkipStage<Stage>{ st_, n }); }
+
+    /* --- терминальные операции: один проход --- */
+    template<typename F>
+    void ForEach(F f) const { st_.Run([&](const value_type& v) { f(v); return true; }); }
+
+    template<typename U, typename R>
+    U Reduce(U init, R r) const {
+        st_.Run([&](const value_type& v) { init = r(std::move(init), v); return true; });
+        return init;
+    }
+    size_t Count() const {
+        size_t c = 0;
+        st_.Run([&](const value_type&) { ++c; return true; });
+        return c;
+    }
+    std::optional<value_type> TryFirst() const {
+        std::optional<value_type> hit;
+        st_.Run([&](const value_type& v) { hit.emplace(v); return false; });
+        return hit;
+    }
+    template<typename P>
+    std::optional<value_type> TryFirst(P p) const { return Where(std::move(p)).TryFirst(); }
+
+    // материализация — единственное место, где появляется контейнер
+    template<typename Out = MutableArraySequence<value_type>>
+    SeqUPtr<value_type> ToSequence() const {
+        auto out = SeqUPtr<value_type>(new Out());
+        st_.Run([&](const value_type& v) { out->Append(v); return true; });
+        return out;
+    }
+};
@@ -0,0 +1,284 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/* Векторные ядра над непрерывным куском [p, p+n) арифметического T.
+   Тело каждого ядра написано один раз на векторных расширениях GCC/Clang
+   (T __attribute__((vector_size(W)))) и собирается трижды — под SSE2 (W=16),
+   AVX2 (W=32) и AVX-512 (W=64); нужная версия выбирается по CPU при первом
+   вызове. Без x86/GNU остаётся скалярная версия.
+
+   Предикаты и отображения — обобщённые лямбды, которые работают и с T,
+   и с вектором T: [](auto x) { return x > 5; }, [](auto x) { return x * 2 + 1; }.
+   Сумма вещественных считается несколькими аккумуляторами, поэтому может
+   отличаться от последовательной в последних битах. */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#include <immintrin.h>
+// GCC выдаёт -Wpsabi ("ABI for passing parameters with 64-byte alignment") на
+// векторные параметры: всё инлайнится в ядро, так что ABI тут не важен.
+// Отключено только внутри заголовка (в конце — pop). На лямбды пользователя
+// замечание выдаётся при генерации кода его файла, и прагма там его не
+// глушит — только флаг сборки -Wno-psabi (см. строки сборки tests.cpp, bench.cpp)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#else
+#define SIMD_X86 0
+#endif
+
+namespace simd {
+
+enum class Isa { Scalar, SSE2, AVX2, AVX512 };
+
+inline const char* IsaName(Isa isa) {
+    switch (isa) {
+        case Isa::SSE2:   return "sse2";
+        case Isa::AVX2:   return "avx2";
+        case Isa::AVX512: return "avx512";
+        default:          return "scalar";
+    }
+}
+
+inline Isa DetectIsa() {
+#if SIMD_X86
+    __builtin_cpu_init();
+#ifdef __OPTIMIZE__
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return Isa::AVX512;
+    if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+#endif
+    // без оптимизации лямбда не инлайнится (flatten не работает на -O0), а 32/64-байтный
+    // вектор в неё из AVX-кода передаётся по другому ABI — остаёмся на SSE2
+    if (__builtin_cpu_supports("sse2")) return Isa::SSE2;
+#endif
+    return Isa::Scalar;
+}
+
+inline Isa& ActiveIsaRef() { static Isa isa = DetectIsa(); return isa; }
+inline Isa  ActiveIsa()    { return ActiveIsaRef(); }
+// для тестов и бенчмарков: не выше того, что умеет CPU
+inline void ForceIsa(Isa isa) {
+    if (static_cast<int>(isa) > static_cast<int>(DetectIsa()))
+        throw std::invalid_argument(std::string("ForceIsa: CPU lacks ") + IsaName(isa));
+    ActiveIsaRef() = isa;
+}
+
+/* типы, для которых есть ядра, и тип суммы (целые — с расширением до 64 бит) */
+template<class T>
+constexpr bool kVectorizable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                               !std::is_same_v<T, long double>;
+template<class T>
+using SumType = std::conditional_t<std::is_floating_point_v<T>, T,
+                std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+
+namespace detail {
+
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+template<class T, size_t W> struct VecOf { typedef T type __attribute__((vector_size(W))); };
+template<class T, size_t W> using Vec = typename VecOf<T, W>::type;
+
+template<class V, class T> SIMD_INLINE V load(const T* p) { V v; std::memcpy(&v, p, sizeof v); return v; }
+template<class V, class T> SIMD_INLINE void store(T* p, const V& v) { std::memcpy(p, &v, sizeof v); }
+
+// W == 0 — только скалярный хвост
+template<size_t W, class T>
+SIMD_INLINE SumType<T> Sum(const T* p, size_t n) {
+    using S = SumType<T>;
+    S total = 0;
+    size_t i = 0;
+    if constexpr (W != 0) {
+        constexpr size_t L = W / sizeof(T);
+        using V  = Vec<T, W>;
+        using VS = Vec<S, L * sizeof(S)>;
+        VS a0 = {}, a1 = {};
+        for (; i + 2 * L <= n; i += 2 * L) {
+            a0 += __builtin_convertvector(load<V>(p + i), VS);
+            a1 += __builtin_convertvector(load<V>(p + i + L), VS);
+        }
+        a0 += a1;
+        for (size_t j = 0; j < L; ++j) total += a0[j];
+    }
+    for (; i < n; ++i) total += p[i];
+    return total;
+}
+
+template<size_t W, bool IsMin, class T>
+SIMD_INLINE T Extreme(const T* p, size_t n) {
+    T best = p[0];
+    size_t i = 1;
+    if constexpr (W != 0) {
+        constexpr size_t L = W / sizeof(T);
+        using V = Vec<T, W>;
+        if (n >= L) {
+            V acc = load<V>(p);
+            for (i = L; i + L <= n; i += L) {
+                V v = load<V>(p + i);
+                if constexpr (IsMin) acc = v < acc ? v : acc;
+                else                 acc = v > acc ? v : acc;
+            }
+            best = acc[0];
+            for (size_t j = 1; j < L; ++j)
+                if (IsMin ? acc[j] < best : acc[j] > best) best = acc[j];
+        }
+    }
+    for (; i < n; ++i)
+        if (IsMin ? p[i] < best : p[i] > best) best = p[i];
+    return best;
+}
+
+template<size_t W, class T, class P>
+SIMD_INLINE size_t CountIf(const T* p, size_t n, P pred) {
+    size_t cnt = 0, i = 0;
+    if constexpr (W != 0) {
+        constexpr size_t L = W / sizeof(T);
+        // счётчики в дорожках маски шириной sizeof(T) — сбрасываем до переполнения;
+        // предикат может вернуть любые ненулевые дорожки ((x & 1)) — != 0 даёт маску -1/0
+        constexpr size_t kFlush = sizeof(T) == 1 ? 64 : sizeof(T) == 2 ? 16384 : (1u << 20);
+        using V = Vec<T, W>;
+        using M = decltype(pred(V{}) != 0);
+        while (i + L <= n) {
+            M acc = {};
+            for (size_t k = 0; k < kFlush && i + L <= n; ++k, i += L) acc -= (pred(load<V>(p + i)) != 0);
+            for (size_t j = 0; j < L; ++j) cnt += static_cast<size_t>(acc[j]);
+        }
+    }
+    for (; i < n; ++i) cnt += pred(p[i]) ? 1 : 0;
+    return cnt;
+}
+
+template<size_t W, class T, class F>
+SIMD_INLINE void Transform(const T* p, size_t n, T* out, F f) {
+    size_t i = 0;
+    if constexpr (W != 0) {
+        constexpr size_t L = W / sizeof(T);
+        using V = Vec<T, W>;
+        for (; i + L <= n; i += L) store(out + i, static_cast<V>(f(load<V>(p + i))));
+    }
+    for (; i < n; ++i) out[i] = static_cast<T>(f(p[i]));
+}
+
+#if SIMD_X86
+/* AVX-512 compress-store для 4- и 8-байтных дорожек. Отдельная функция с target:
+   интринсики нельзя заинлайнить в тело ядра, у которого target не задан */
+template<class T, class V, class M>
+__attribute__((target("avx512f"))) inline size_t CompressStore512(T* out, const V& v, const M& m) {
+    __m512i vi, mi;
+    std::memcpy(&vi, &v, sizeof vi);
+    std::memcpy(&mi, &m, sizeof mi);
+    if constexpr (sizeof(T) == 4) {
+        __mmask16 bits = _mm512_test_epi32_mask(mi, mi);
+        _mm512_mask_compressstoreu_epi32(out, bits, vi);
+        return __builtin_popcount(bits);
+    } else {
+        __mmask8 bits = _mm512_test_epi64_mask(mi, mi);
+        _mm512_mask_compressstoreu_epi64(out, bits, vi);
+        return __builtin_popcount(bits);
+    }
+}
+#endif
+
+// фильтрация со сжатием: подходящие элементы подряд в out, возвращает их число
+template<size_t W, class T, class P>
+SIMD_INLINE size_t Compact(const T* p, size_t n, T* out, P pred) {
+    size_t k = 0, i = 0;
+    if constexpr (W != 0) {
+        constexpr size_t L = W / sizeof(T);
+        using V = Vec<T, W>;
+        for (; i + L <= n; i += L) {
+            V v = load<V>(p + i);
+            auto m = pred(v);
+#if SIMD_X86
+            if constexpr (W == 64 && (sizeof(T) == 4 || sizeof(T) == 8)) {
+                k += CompressStore512(out + k, v, m);
+                continue;
+            }
+#endif
+            // без compress-store: безветвенная запись по дорожкам
+            for (size_t j = 0; j < L; ++j) { out[k] = v[j]; k += m[j] != 0; }
+        }
+    }
+    for (; i < n; ++i) { out[k] = p[i]; k += pred(p[i]) ? 1 : 0; }
+    return k;
+}
+
+// индекс первого подходящего или n
+template<size_t W, class T, class P>
+SIMD_INLINE size_t FindFirst(const T* p, size_t n, P pred) {
+    size_t i = 0;
+    if constexpr (W != 0) {
+        constexpr size_t L = W / sizeof(T);
+        using V = Vec<T, W>;
+        for (; i + L <= n; i += L) {
+            auto m = pred(load<V>(p + i));
+            decltype(m) zero = {};
+            if (std::memcmp(&m, &zero, sizeof m) == 0) continue;
+            for (size_t j = 0; j < L; ++j) if (m[j]) return i + j;
+        }
+    }
+    for (; i < n; ++i) if (pred(p[i])) return i;
+    return n;
+}
+
+/* для каждого ядра — три версии под свои target и диспетчер */
+#if SIMD_X86
+#define SIMD_TARGETS(Name)                                                                    \
+    template<class T, class... A> __attribute__((target("sse2"), flatten))\
+    auto Name##Sse2(const T* p, size_t n, A... a) { return Name<16>(p, n, a...); }            \
+    template<class T, class... A> __attribute__((target("avx2"), flatten))\
+    auto Name##Avx2(const T* p, size_t n, A... a) { return Name<32>(p, n, a...); }            \
+    template<class T, class... A> __attribute__((target("avx512f,avx512bw"), flatten))\
+    auto Name##Avx512(const T* p, size_t n, A... a) { return Name<64>(p, n, a...); }          \
+    template<class T, class... A>                                                             \
+    auto Name##Dispatch(const T* p, size_t n, A... a) {                                       \
+        switch (ActiveIsa()) {                                                                \
+            case Isa::AVX512: return Name##Avx512(p, n, a...);                                \
+            case Isa::AVX2:   return Name##Avx2(p, n, a...);                                  \
+            case Isa::SSE2:   return Name##Sse2(p, n, a...);                                  \
+            default:          return Name<0>(p, n, a...);                                     \
+        }                                                                                     \
+    }
+#else
+#define SIMD_TARGETS(Name)                                                                    \
+    template<class T, class... A>                                                             \
+    auto Name##Dispatch(const T* p, size_t n, A... a) { return Name<0>(p, n, a...); }
+#endif
+
+template<size_t W, class T> SIMD_INLINE T Min(const T* p, size_t n) { return Extreme<W, true>(p, n); }
+template<size_t W, class T> SIMD_INLINE T Max(const T* p, size_t n) { return Extreme<W, false>(p, n); }
+
+SIMD_TARGETS(Sum)
+SIMD_TARGETS(Min)
+SIMD_TARGETS(Max)
+SIMD_TARGETS(CountIf)
+SIMD_TARGETS(Transform)
+SIMD_TARGETS(Compact)
+SIMD_TARGETS(FindFirst)
+
+#undef SIMD_TARGETS
+} // namespace detail
+
+/* --- публичные ядра --- */
+template<class T> SumType<T> Sum(const T* p, size_t n) { return detail::SumDispatch(p, n); }
+template<class T> T Min(const T* p, size_t n) {
+    if (!n) throw std::out_of_range("simd::Min: empty range");
+    return detail::MinDispatch(p, n);
+}
+template<class T> T Max(const T* p, size_t n) {
+    if (!n) throw std::out_of_range("simd::Max: empty range");
+    return detail::MaxDispatch(p, n);
+}
+template<class T, class P> size_t CountIf(const T* p, size_t n, P pred) { return detail::CountIfDispatch(p, n, pred); }
+template<class T, class F> void   Transform(const T* p, size_t n, T* out, F f) { detail::TransformDispatch(p, n, out, f); }
+template<class T, class P> size_t Compact(const T* p, size_t n, T* out, P pred) { return detail::CompactDispatch(p, n, out, pred); }
+template<class T, class P> size_t FindFirst(const T* p, size_t n, P pred) { return detail::FindFirstDispatch(p, n, pred); }
+
+} // namespace simd
+
+#undef SIMD_INLINE
+#if SIMD_X86
+#pragma GCC diagnostic pop
+#endif
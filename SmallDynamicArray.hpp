@@ -0,0 +1,172 @@
+#pragma once
+#include "BoundsCheck.hpp"
+#include "ChunkCursor.hpp"
+#include "DynamicArray.hpp"
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/* Массив с inline-буфером на N элементов: пока size_ <= N, куча не трогается;
+   при переполнении элементы переезжают в кучу (рост — как у DynamicArray). */
+template<typename T, size_t N, typename Growth = GrowDouble>
+class SmallDynamicArray {
+    static_assert(N > 0, "SmallDynamicArray: N must be positive");
+
+    size_t size_     = 0;
+    size_t capacity_ = N;
+    T*     data_;
+    alignas(T) unsigned char inline_[N*sizeof(T)];
+
+    static constexpr bool kTrivial = std::is_trivially_copyable_v<T>;
+
+    T*   inlineBuf() { return std::launder(reinterpret_cast<T*>(inline_)); }
+    bool isInline() const { return data_ == reinterpret_cast<const T*>(inline_); }
+
+    void check(size_t i) const { if (i >= size_) detail::ThrowIndexOutOfRange(i, size_); }
+    static void relocate(T* src,size_t n,T* dst){
+        if constexpr (kTrivial) {
+            if(n) std::memcpy(static_cast<void*>(dst), src, n*sizeof(T));
+        } else {
+            for(size_t i=0;i<n;++i){
+                ::new (static_cast<void*>(dst+i)) T(std::move_if_noexcept(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+    void shiftLeft(size_t from,size_t to){
+        size_t gap = from-to;
+        if constexpr (kTrivial) {
+            std::memmove(static_cast<void*>(data_+to), data_+from, (size_-from)*sizeof(T));
+        } else {
+            std::move(data_+from, data_+size_, data_+to);
+            std::destroy(data_+size_-gap, data_+size_);
+        }
+        size_ -= gap;
+    }
+    void release(){
+        std::destroy(data_, data_+size_);
+        if(!isInline()) std::allocator<T>().deallocate(data_, capacity_);
+        data_ = inlineBuf(); capacity_ = N; size_ = 0;
+    }
+    // забрать содержимое o (o остаётся пустым, inline)
+    void steal(SmallDynamicArray& o) noexcept {
+        if(o.isInline()){
+            relocate(o.data_, o.size_, data_);
+            size_ = o.size_;
+        } else {
+            data_ = o.data_; size_ = o.size_; capacity_ = o.capacity_;
+            o.data_ = o.inlineBuf(); o.capacity_ = N;
+        }
+        o.size_ = 0;
+    }
+
+public:
+    /* --- ctors --- */
+    SmallDynamicArray() : data_(inlineBuf()) {}
+    SmallDynamicArray(const T* src,size_t n) : SmallDynamicArray() {
+        Reserve(n);
+        std::uninitialized_copy(src, src+n, data_);
+        size_ = n;
+    }
+    SmallDynamicArray(const SmallDynamicArray& o) : SmallDynamicArray(o.data_, o.size_) {}
+    SmallDynamicArray(SmallDynamicArray&& o) noexcept : SmallDynamicArray() { steal(o); }
+
+    SmallDynamicArray& operator=(const SmallDynamicArray& o){
+        if(this != &o){ SmallDynamicArray tmp(o); release(); steal(tmp); }
+        return *this;
+    }
+    SmallDynamicArray& operator=(SmallDynamicArray&& o) noexcept {
+        if(this != &o){ release(); steal(o); }
+        return *this;
+    }
+    ~SmallDynamicArray(){ release(); }
+
+    /* --- access --- */
+    size_t GetSize()     const { return size_; }
+    size_t GetCapacity() const { return capacity_; }
+    bool   IsInline()    const { return isInline(); }
+
+    T&       operator[](size_t i){ check(i); return data_[i]; }
+    const T& operator[](size_t i) const { check(i); return data_[i]; }
+
+    T*       begin()       { return data_; }
+    T*       end()         { return data_+size_; }
+    const T* begin() const { return data_; }
+    const T* end()   const { return data_+size_; }
+
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const {
+        if(c.pos>=size_) return false;
+        p = data_+c.pos; n = size_-c.pos; c.pos = size_;
+        return true;
+    }
+
+    /* --- capacity --- */
+    void Reserve(size_t newCap){
+        if(newCap<=capacity_) return;
+        T* tmp = std::allocator<T>().allocate(newCap);
+        relocate(data_, size_, tmp);
+        if(!isInline()) std::allocator<T>().deallocate(data_, capacity_);
+        data_ = tmp; capacity_ = newCap;
+    }
+    void Resize(size_t n){
+        if(n > size_){
+            Reserve(n);
+            std::uninitialized_value_construct(data_+size_, data_+n);
+        } else {
+            std::destroy(data_+n, data_+size_);
+        }
+        size_ = n;
+    }
+    template<typename... A>
+    T& EmplaceBack(A&&... a){
+        if(size_==capacity_){
+            T tmp(std::forward<A>(a)...);   // аргументы могут ссылаться внутрь data_
+            Reserve(Growth::Next(capacity_));
+            ::new (static_cast<void*>(data_+size_)) T(std::move(tmp));
+        } else {
+            ::new (static_cast<void*>(data_+size_)) T(std::forward<A>(a)...);
+        }
+        return data_[size_++];
+    }
+    void PushBack(const T& v){ EmplaceBack(v); }
+    void PushBack(T&& v)     { EmplaceBack(std::move(v)); }
+    // вставка в произвольное место: в конец, затем поворот
+    template<typename... A>
+    T& Emplace(size_t i,A&&... a){
+        if(i>size_) throw std::out_of_range("InsertAt: idx="+std::to_string(i));
+        EmplaceBack(std::forward<A>(a)...);
+        std::rotate(data_+i, data_+size_-1, data_+size_);
+        return data_[i];
+    }
+    void InsertAt(const T& v,size_t i){ Emplace(i, v); }
+    void InsertAt(T&& v,size_t i)     { Emplace(i, std::move(v)); }
+
+    /* --- removal --- */
+    T PopBack(){
+        if(!size_) throw std::out_of_range("PopBack: empty array");
+        T v = std::move(data_[size_-1]);
+        data_[--size_].~T();
+        return v;
+    }
+    T RemoveAt(size_t i){
+        check(i);
+        T v = std::move(data_[i]);
+        shiftLeft(i+1, i);
+        return v;
+    }
+    void Erase(size_t l,size_t r){          // [l, r]
+        if(l>r || r>=size_) throw std::out_of_range("Erase: bad range");
+        shiftLeft(r+1, l);
+    }
+
+    void swap(SmallDynamicArray& o) noexcept {
+        SmallDynamicArray tmp(std::move(o));
+        o = std::move(*this);
+        *this = std::move(tmp);
+    }
+};
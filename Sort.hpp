@@ -0,0 +1,401 @@
+#pragma once
+#include "MutableArraySequence.hpp"
+#include "MutableListSequence.hpp"
+#include "SequenceSlice.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/* Сортировки Sort / StableSort / PartialSort / NthElement и параллельные
+   ParallelSort / ParallelStableSort.
+
+   Ядра (namespace sorting) работают на сырых указателях [b, e):
+     PdqSort      — introsort в варианте pdqsort: опорный — медиана трёх
+                    (или девяти на больших кусках), малые куски — вставками,
+                    после череды плохих разбиений — heapsort (O(n log n) всегда).
+                    Уже упорядоченные куски и много равных ключей распознаются;
+     Select       — quickselect на тех же разбиениях, для NthElement / PartialSort;
+     ParallelMergeSort — куски по потокам сортируются отдельно, затем попарно
+                    сливаются; каждое слияние делится между задачами по
+                    диагоналям (merge path), так что последний раунд тоже параллелен.
+   Контейнеры:
+     массивы (DynamicArray, MutableArraySequence, изменяемый SequenceSlice) —
+       на месте, в своём буфере (общий буфер сначала копируется, как при записи);
+     LinkedList / UnrolledLinkedList (и MutableListSequence на них) — Sort
+       самого списка: LinkedList перецепляет узлы, значения не трогаются;
+     прочие последовательности — через временный массив и EraseRange + Append.
+   На списках все четыре операции — полная устойчивая сортировка. */
+
+namespace sorting {
+
+constexpr size_t kInsertion = 24;      // меньше — сортировка вставками
+constexpr size_t kNinther   = 128;     // больше — опорный по медиане девяти
+
+template<typename T, typename Cmp>
+void InsertionSort(T* b, T* e, Cmp& cmp) {
+    if (b == e) return;
+    for (T* i = b + 1; i < e; ++i) {
+        if (!cmp(*i, *(i - 1))) continue;
+        T v = std::move(*i);
+        T* j = i;
+        do { *j = std::move(*(j - 1)); --j; } while (j != b && cmp(v, *(j - 1)));
+        *j = std::move(v);
+    }
+}
+
+// вставками, но сдаётся после 8 перемещений: дёшево проверяет «почти отсортировано»
+template<typename T, typename Cmp>
+bool PartialInsertionSort(T* b, T* e, Cmp& cmp) {
+    if (b == e) return true;
+    size_t moved = 0;
+    for (T* i = b + 1; i < e; ++i) {
+        if (!cmp(*i, *(i - 1))) continue;
+        T v = std::move(*i);
+        T* j = i;
+        do { *j = std::move(*(j - 1)); --j; } while (j != b && cmp(v, *(j - 1)));
+        *j = std::move(v);
+        moved += static_cast<size_t>(i - j);
+        if (moved > 8) return false;
+    }
+    return true;
+}
+
+template<typename T, typename Cmp>
+void Sort3(T* a, T* b, T* c, Cmp& cmp) {
+    if (cmp(*b, *a)) std::iter_swap(a, b);
+    if (cmp(*c, *b)) {
+        std::iter_swap(b, c);
+        if (cmp(*b, *a)) std::iter_swap(a, b);
+    }
+}
+
+// медиана в *b, элемент не меньше неё — в e[-1] (страж для PartitionRight)
+template<typename T, typename Cmp>
+void ChoosePivot(T* b, T* e, Cmp& cmp) {
+    size_t n = static_cast<size_t>(e - b), h = n / 2;
+    if (n > kNinther) {
+        Sort3(b, b + h, e - 1, cmp);
+        Sort3(b + 1, b + h - 1, e - 2, cmp);
+        Sort3(b + 2, b + h + 1, e - 3, cmp);
+        Sort3(b + h - 1, b + h, b + h + 1, cmp);
+        std::iter_swap(b, b + h);
+    } else {
+        Sort3(b + h, b, e - 1, cmp);
+    }
+}
+
+// разбиение вокруг *b: [b, p) < pivot, [p+1, e) >= pivot; second — перестановок не было
+template<typename T, typename Cmp>
+std::pair<T*, bool> PartitionRight(T* b, T* e, Cmp& cmp) {
+    T pivot = std::move(*b);
+    T* first = b;
+    T* last = e;
+    while (cmp(*++first, pivot)) {}
+    if (first - 1 == b) while (first < last && !cmp(*--last, pivot)) {}
+    else                while (!cmp(*--last, pivot)) {}
+    bool already = first >= last;
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (cmp(*++first, pivot)) {}
+        while (!cmp(*--last, pivot)) {}
+    }
+    T* p = first - 1;
+    *b = std::move(*p);
+    *p = std::move(pivot);
+    return { p, already };
+}
+
+// равные опорному уходят влево; зовётся, когда опорный равен элементу перед куском
+template<typename T, typename Cmp>
+T* PartitionLeft(T* b, T* e, Cmp& cmp) {
+    T pivot = std::move(*b);
+    T* first = b;
+    T* last = e;
+    while (cmp(pivot, *--last)) {}
+    if (last + 1 == e) while (first < last && !cmp(pivot, *++first)) {}
+    else               while (!cmp(pivot, *++first)) {}
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (cmp(pivot, *--last)) {}
+        while (!cmp(pivot, *++first)) {}
+    }
+    *b = std::move(*last);
+    *last = std::move(pivot);
+    return last;
+}
+
+inline int Log2(size_t n) { int k = 0; while (n >>= 1) ++k; return k; }
+
+// перемешивание вокруг опорного после сильно несбалансированного разбиения
+template<typename T>
+void BreakPatterns(T* b, T* e) {
+    size_t n = static_cast<size_t>(e - b);
+    if (n < kInsertion) return;
+    std::iter_swap(b, b + n / 4);
+    std::iter_swap(e - 1, e - n / 4);
+    if (n > kNinther) {
+        std::iter_swap(b + 1, b + (n / 4 + 1));
+        std::iter_swap(b + 2, b + (n / 4 + 2));
+        std::iter_swap(e - 2, e - (n / 4 + 1));
+        std::iter_swap(e - 3, e - (n / 4 + 2));
+    }
+}
+
+template<typename T, typename Cmp>
+void PdqLoop(T* b, T* e, Cmp& cmp, int badAllowed, bool leftmost) {
+    for (;;) {
+        size_t n = static_cast<size_t>(e - b);
+        if (n < kInsertion) { InsertionSort(b, e, cmp); return; }
+        ChoosePivot(b, e, cmp);
+        // опорный равен элементу слева от куска: все равные ему — сразу на место
+        if (!leftmost && !cmp(*(b - 1), *b)) { b = PartitionLeft(b, e, cmp) + 1; continue; }
+
+        auto [p, already] = PartitionRight(b, e, cmp);
+        size_t l = static_cast<size_t>(p - b), r = static_cast<size_t>(e - p - 1);
+        if (l < n / 8 || r < n / 8) {
+            if (--badAllowed == 0) { std::make_heap(b, e, cmp); std::sort_heap(b, e, cmp); return; }
+            BreakPatterns(b, p);
+            BreakPatterns(p + 1, e);
+        } else if (already && PartialInsertionSort(b, p, cmp) && PartialInsertionSort(p + 1, e, cmp)) {
+            return;
+        }
+        PdqLoop(b, p, cmp, badAllowed, leftmost);
+        b = p + 1;
+        leftmost = false;
+    }
+}
+
+template<typename T, typename Cmp>
+void PdqSort(T* b, T* e, Cmp& cmp) {
+    if (e - b > 1) PdqLoop(b, e, cmp, Log2(static_cast<size_t>(e - b)), true);
+}
+
+// после вызова *nth — тот же элемент, что и в отсортированном [b, e); слева не больше, справа не меньше
+template<typename T, typename Cmp>
+void Select(T* b, T* nth, T* e, Cmp& cmp) {
+    if (nth >= e) return;
+    int bad = Log2(static_cast<size_t>(e - b));
+    while (static_cast<size_t>(e - b) >= kInsertion) {
+        size_t n = static_cast<size_t>(e - b);
+        ChoosePivot(b, e, cmp);
+        T* p = PartitionRight(b, e, cmp).first;
+        if (p == nth) return;
+        size_t l = static_cast<size_t>(p - b), r = static_cast<size_t>(e - p - 1);
+        if ((l < n / 8 || r < n / 8) && --bad == 0) { std::nth_element(b, nth, e, cmp); return; }
+        if (nth < p) e = p; else b = p + 1;
+    }
+    InsertionSort(b, e, cmp);
+}
+
+// k наименьших — по порядку в начале: Select за O(n), потом сортировка префикса
+template<typename T, typename Cmp>
+void PartialSort(T* b, T* mid, T* e, Cmp& cmp) {
+    if (mid == b) return;
+    if (mid < e) Select(b, mid - 1, e, cmp);
+    PdqSort(b, mid, cmp);
+}
+
+template<typename T, typename Cmp>
+void StableSort(T* b, T* e, Cmp& cmp) { std::stable_sort(b, e, cmp); }
+
+// сколько элементов a входит в первые d выхода устойчивого слияния a и b (merge path)
+template<typename T, typename Cmp>
+size_t CoRank(size_t d, const T* a, size_t na, const T* b, size_t nb, Cmp& cmp) {
+    size_t lo = d > nb ? d - nb : 0, hi = std::min(d, na);
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2, j = d - i;
+        if (j > 0 && !cmp(b[j - 1], a[i])) lo = i + 1;   // a[i] уходит раньше b[j-1]
+        else hi = i;
+    }
+    return lo;
+}
+
+// устойчивое слияние [a, a+na) и [b, b+nb) в out, выход поделён между задачами пула.
+// Точки раздела считаются до слияния: перенос портит исходные элементы (строки пустеют)
+template<typename T, typename Cmp>
+void ParallelMerge(T* a, size_t na, T* b, size_t nb, T* out, Cmp& cmp, ThreadPool& pool, Grain grain) {
+    const size_t n = na + nb, chunk = grain.ChunkFor(n, pool.Size()), parts = (n + chunk - 1) / chunk;
+    std::vector<size_t> split(parts + 1, na);
+    pool.ParallelFor(parts, size_t(1), [&](size_t p0, size_t p1) {
+        for (size_t p = p0; p < p1; ++p) split[p] = CoRank(p * chunk, a, na, b, nb, cmp);
+    });
+    pool.ParallelFor(n, chunk, [&](size_t d0, size_t d1) {
+        size_t i0 = split[d0 / chunk], i1 = split[d0 / chunk + 1];
+        std::merge(std::make_move_iterator(a + i0), std::make_move_iterator(a + i1),
+                   std::make_move_iterator(b + d0 - i0), std::make_move_iterator(b + d1 - i1),
+                   out + d0, cmp);
+    });
+}
+
+/* куски по потокам сортирует sortRun (PdqSort или StableSort), затем
+   log2(кусков) раундов попарного слияния через буфер того же размера */
+template<typename T, typename Cmp, typename S>
+void ParallelMergeSort(T* a, size_t n, Cmp& cmp, ThreadPool& pool, Grain grain, S sortRun) {
+    size_t runs = std::min(pool.Size(), n / std::max<size_t>(grain.MinChunk, 1));
+    if (runs < 2) { sortRun(a, a + n); return; }
+    std::vector<size_t> at(runs + 1);
+    for (size_t i = 0; i <= runs; ++i) at[i] = n * i / runs;
+    pool.ParallelFor(runs, size_t(1), [&](size_t r0, size_t r1) {
+        for (size_t r = r0; r < r1; ++r) sortRun(a + at[r], a + at[r + 1]);
+    });
+
+    std::vector<T> buf(std::make_move_iterator(a), std::make_move_iterator(a + n));
+    T* src = buf.data();
+    T* dst = a;
+    for (; at.size() > 2; std::swap(src, dst)) {
+        std::vector<size_t> next{ 0 };
+        for (size_t r = 0; r + 1 < at.size(); r += 2) {
+            size_t l = at[r], m = at[r + 1];
+            if (r + 2 < at.size()) {
+                size_t e = at[r + 2];
+                ParallelMerge(src + l, m - l, src + m, e - m, dst + l, cmp, pool, grain);
+                next.push_back(e);
+            } else {                                 // нечётный кусок — без пары
+                std::move(src + l, src + m, dst + l);
+                next.push_back(m);
+            }
+        }
+        at.swap(next);
+    }
+    if (src != a) std::move(src, src + n, a);
+}
+
+} // namespace sorting
+
+/* ---------- массивы на месте ---------- */
+template<typename T, typename G, typename B, typename Cmp = std::less<>>
+void Sort(DynamicArray<T,G,B>& a, Cmp cmp = Cmp()) { sorting::PdqSort(a.begin(), a.end(), cmp); }
+
+template<typename T, typename G, typename B, typename Cmp = std::less<>>
+void StableSort(DynamicArray<T,G,B>& a, Cmp cmp = Cmp()) { sorting::StableSort(a.begin(), a.end(), cmp); }
+
+template<typename T, typename G, typename B, typename Cmp = std::less<>>
+void PartialSort(DynamicArray<T,G,B>& a, size_t k, Cmp cmp = Cmp()) {
+    if (k > a.GetSize()) throw std::out_of_range("PartialSort: k > size");
+    sorting::PartialSort(a.begin(), a.begin() + k, a.end(), cmp);
+}
+
+template<typename T, typename G, typename B, typename Cmp = std::less<>>
+void NthElement(DynamicArray<T,G,B>& a, size_t k, Cmp cmp = Cmp()) {
+    if (k >= a.GetSize()) throw std::out_of_range("NthElement: k >= size");
+    sorting::Select(a.begin(), a.begin() + k, a.end(), cmp);
+}
+
+template<typename T, typename G, typename B, typename Cmp = std::less<>>
+void ParallelSort(DynamicArray<T,G,B>& a, Cmp cmp = Cmp(),
+                  ThreadPool& pool = ThreadPool::Default(), Grain grain = Grain()) {
+    sorting::ParallelMergeSort(a.begin(), a.GetSize(), cmp, pool, grain,
+                               [&cmp](T* b, T* e) { sorting::PdqSort(b, e, cmp); });
+}
+
+template<typename T, typename G, typename B, typename Cmp = std::less<>>
+void ParallelStableSort(DynamicArray<T,G,B>& a, Cmp cmp = Cmp(),
+                        ThreadPool& pool = ThreadPool::Default(), Grain grain = Grain()) {
+    sorting::ParallelMergeSort(a.begin(), a.GetSize(), cmp, pool, grain,
+                               [&cmp](T* b, T* e) { sorting::StableSort(b, e, cmp); });
+}
+
+/* ---------- последовательности ---------- */
+namespace detail {
+    // изменяемый буфер массива-источника любой из политик проверки индекса
+    template<typename... Arr, typename T>
+    T* WritableOf(Sequence<T>& s)
+    {
+        T* p = nullptr;
+        ((dynamic_cast<Arr*>(&s) ? (p = static_cast<Arr&>(s).data(), true) : false) || ...);
+        return p;
+    }
+
+    /* f(T* b, T* e) над элементами s: массивы — на месте, прочие — через
+       временный массив, который потом заменяет содержимое s */
+    template<typename T, typename F>
+    void SortInPlace(Sequence<T>& s, F f)
+    {
+        size_t n = s.GetLength();
+        if (n < 2) return;
+        if (T* p = WritableOf<MutableArraySequence<T, CheckedBounds>, MutableArraySequence<T, AssertBounds>,
+                              MutableArraySequence<T, UncheckedBounds>, SequenceSlice<T>>(s)) {
+            f(p, p + n);
+            return;
+        }
+        DynamicArray<T> d;
+        d.Reserve(n);
+        s.ForEachChunk([&d](const T* p, size_t k) { d.AppendRange(p, p + k); return true; });
+        f(d.begin(), d.end());
+        s.EraseRange(0, n - 1);
+        for (T& v : d) s.Append(std::move(v));
+    }
+}
+
+template<typename T, typename Cmp = std::less<>>
+void Sort(Sequence<T>& s, Cmp cmp = Cmp())
+{
+    detail::SortInPlace(s, [&cmp](T* b, T* e) { sorting::PdqSort(b, e, cmp); });
+}
+
+template<typename T, typename Cmp = std::less<>>
+void StableSort(Sequence<T>& s, Cmp cmp = Cmp())
+{
+    detail::SortInPlace(s, [&cmp](T* b, T* e) { sorting::StableSort(b, e, cmp); });
+}
+
+/* первые k элементов — k наименьших по порядку, остальные — в произвольном */
+template<typename T, typename Cmp = std::less<>>
+void PartialSort(Sequence<T>& s, size_t k, Cmp cmp = Cmp())
+{
+    if (k > s.GetLength()) throw std::out_of_range("PartialSort: k > length");
+    detail::SortInPlace(s, [&cmp, k](T* b, T* e) { sorting::PartialSort(b, b + k, e, cmp); });
+}
+
+/* на месте k — элемент, который стоял бы там после Sort; слева не больше, справа не меньше */
+template<typename T, typename Cmp = std::less<>>
+void NthElement(Sequence<T>& s, size_t k, Cmp cmp = Cmp())
+{
+    if (k >= s.GetLength()) throw std::out_of_range("NthElement: k >= length");
+    detail::SortInPlace(s, [&cmp, k](T* b, T* e) { sorting::Select(b, b + k, e, cmp); });
+}
+
+template<typename T, typename Cmp = std::less<>>
+void ParallelSort(Sequence<T>& s, Cmp cmp = Cmp(),
+                  ThreadPool& pool = ThreadPool::Default(), Grain grain = Grain())
+{
+    detail::SortInPlace(s, [&](T* b, T* e) {
+        sorting::ParallelMergeSort(b, static_cast<size_t>(e - b), cmp, pool, grain,
+                                   [&cmp](T* x, T* y) { sorting::PdqSort(x, y, cmp); });
+    });
+}
+
+template<typename T, typename Cmp = std::less<>>
+void ParallelStableSort(Sequence<T>& s, Cmp cmp = Cmp(),
+                        ThreadPool& pool = ThreadPool::Default(), Grain grain = Grain())
+{
+    detail::SortInPlace(s, [&](T* b, T* e) {
+        sorting::ParallelMergeSort(b, static_cast<size_t>(e - b), cmp, pool, grain,
+                                   [&cmp](T* x, T* y) { sorting::StableSort(x, y, cmp); });
+    });
+}
+
+/* ---------- списки: сортировка самого хранилища, без временного массива ---------- */
+template<typename T, typename List, typename Cmp = std::less<>>
+void Sort(MutableListSequence<T, List>& s, Cmp cmp = Cmp())       { s.Sort(cmp); }
+
+template<typename T, typename List, typename Cmp = std::less<>>
+void StableSort(MutableListSequence<T, List>& s, Cmp cmp = Cmp()) { s.Sort(cmp); }
+
+template<typename T, typename List, typename Cmp = std::less<>>
+void PartialSort(MutableListSequence<T, List>& s, size_t k, Cmp cmp = Cmp())
+{
+    if (k > s.GetLength()) throw std::out_of_range("PartialSort: k > length");
+    s.Sort(cmp);
+}
+
+template<typename T, typename List, typename Cmp = std::less<>>
+void NthElement(MutableListSequence<T, List>& s, size_t k, Cmp cmp = Cmp())
+{
+    if (k >= s.GetLength()) throw std::out_of_range("NthElement: k >= length");
+    s.Sort(cmp);
+}
@@ -1,27 +1,30 @@
 #pragma once
 #include "Sequence.hpp"
 #include "MutableArraySequence.hpp"
+#include "Stats.hpp"
 #include <cassert>
 #include <iostream>
 
+/* с -DSEQ_STATS Stats() считает вставки, снятия и снятия, перестроившие хранилище */
 template<class T>
-class Stack {
+class Stack : protected stats::Counters<stats::AdapterKind> {
+    using K = stats::AdapterKind;
 private:
     std::unique_ptr<Sequence<T>> seq;
 public:
     Stack() : seq(new MutableArraySequence<T>()) {}
-    void Push(const T& item) { seq->Append(item); }
+    void Push(const T& item) { Add(K::Pushes); seq->Append(item); }
+    void Push(T&& item)      { Add(K::Pushes); seq->Append(std::move(item)); }
+    template<class... A> void Emplace(A&&... a) { Add(K::Pushes); seq->EmplaceBack(std::forward<A>(a)...); }
+    const T& Top() const {
+        assert(seq->GetLength() > 0);
+        return seq->GetLast();
+    }
     T Pop() {
         assert(seq->GetLength() > 0);
-        size_t idx = seq->GetLength() - 1;
-        T item = seq->Get(idx);
-        if (idx > 0) {
-            seq = seq->GetSubsequence(0, idx - 1);
-        } else {
-            seq.reset(new MutableArraySequence<T>());
-        }
-        return item;
+        return stats::CountPop(*this, [this] { return seq->PopBack(); });
     }
+    using stats::Counters<K>::Stats;
     size_t Size() const { return seq->GetLength(); }
     void Print() const {
         size_t n = seq->GetLength();
@@ -0,0 +1,164 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* Счётчики контейнеров: что контейнер сделал, а не сколько это заняло.
+   Включаются флагом сборки -DSEQ_STATS. Без него Counters<K> — пустая база
+   (EBO: размер контейнера не меняется), все вызовы пустые и выкидываются.
+   С флагом у экземпляра свои счётчики (Stats()), а каждое событие ещё и
+   прибавляется к общей сумме по виду контейнера (атомарно, из любых потоков):
+     stats::Global<K>() — сумма по всем экземплярам вида K;
+     stats::DumpJson()  — все виды одним JSON-объектом;
+     stats::Reset()     — обнулить общие суммы.
+   Копия контейнера — новый экземпляр: её счётчики начинаются с нуля. */
+
+namespace stats {
+
+#ifdef SEQ_STATS
+constexpr bool kEnabled = true;
+#else
+constexpr bool kEnabled = false;
+#endif
+
+/* --- виды контейнеров: индексы и имена счётчиков; kMoved — счётчик байт,
+   которые хранилище переложило (для RebuildingPops адаптеров), -1 — нет --- */
+struct ArrayKind {                       // DynamicArray
+    enum { Reserves, Regrowths, BytesMoved, PeakCapacity, N };
+    static constexpr int kMoved = BytesMoved;
+    static constexpr const char* kName = "DynamicArray";
+    static constexpr const char* kFields[N] = { "reserves", "regrowths", "bytes_moved", "peak_capacity" };
+};
+struct ListKind {                        // LinkedList
+    enum { NodesAllocated, NodesFreed, PointerHops, N };
+    static constexpr int kMoved = -1;
+    static constexpr const char* kName = "LinkedList";
+    static constexpr const char* kFields[N] = { "nodes_allocated", "nodes_freed", "pointer_hops" };
+};
+struct SequenceKind {                    // классы последовательностей
+    enum { FullCopies, BytesCopied, N };
+    static constexpr int kMoved = BytesCopied;
+    static constexpr const char* kName = "Sequence";
+    static constexpr const char* kFields[N] = { "full_copies", "bytes_copied" };
+};
+struct AdapterKind {                     // Stack / Queue / Deque
+    enum { Pushes, Pops, RebuildingPops, N };
+    static constexpr int kMoved = -1;
+    static constexpr const char* kName = "Adapter";
+    static constexpr const char* kFields[N] = { "pushes", "pops", "rebuilding_pops" };
+};
+
+/* значения счётчиков вида K на момент запроса */
+template<class K>
+struct Snapshot {
+    uint64_t v[K::N] = {};
+
+    uint64_t operator[](int f) const { return v[f]; }
+    std::string Json() const {
+        std::string s = "{";
+        for (int f = 0; f < K::N; ++f)
+            s += std::string(f ? ", \"" : "\"") + K::kFields[f] + "\": " + std::to_string(v[f]);
+        return s + "}";
+    }
+};
+
+namespace detail {
+    template<class K>
+    struct Totals { std::atomic<uint64_t> v[K::N] = {}; };
+
+    template<class K>
+    Totals<K>& GlobalTotals() { static Totals<K> t; return t; }
+
+    // байты, переложенные хранилищами в этом потоке: адаптер сравнивает до и после Pop
+    inline thread_local uint64_t tl_moved = 0;
+
+    inline void AtomicMax(std::atomic<uint64_t>& a, uint64_t x) {
+        uint64_t cur = a.load(std::memory_order_relaxed);
+        while (cur < x && !a.compare_exchange_weak(cur, x, std::memory_order_relaxed)) {}
+    }
+}
+
+template<class K>
+Snapshot<K> Global() {
+    Snapshot<K> s;
+    if constexpr (kEnabled)
+        for (int f = 0; f < K::N; ++f) s.v[f] = detail::GlobalTotals<K>().v[f].load(std::memory_order_relaxed);
+    return s;
+}
+
+inline void Reset() {
+    auto zero = [](auto& t) { for (auto& a : t.v) a.store(0, std::memory_order_relaxed); };
+    zero(detail::GlobalTotals<ArrayKind>());
+    zero(detail::GlobalTotals<ListKind>());
+    zero(detail::GlobalTotals<SequenceKind>());
+    zero(detail::GlobalTotals<AdapterKind>());
+}
+
+inline std::string DumpJson() {
+    return std::string("{\"enabled\": ") + (kEnabled ? "true" : "false")
+         + ", \"" + ArrayKind::kName    + "\": " + Global<ArrayKind>().Json()
+         + ", \"" + ListKind::kName     + "\": " + Global<ListKind>().Json()
+         + ", \"" + SequenceKind::kName + "\": " + Global<SequenceKind>().Json()
+         + ", \"" + AdapterKind::kName  + "\": " + Global<AdapterKind>().Json() + "}";
+}
+
+/* база контейнера; счётчики mutable — события случаются и в const-методах (Get, копии) */
+#ifdef SEQ_STATS
+template<class K>
+class Counters {
+    mutable uint64_t v_[K::N] = {};
+public:
+    Counters() = default;
+    Counters(const Counters&) {}
+    Counters& operator=(const Counters&) { return *this; }
+
+    void Add(int f, uint64_t d = 1) const {
+        v_[f] += d;
+        detail::GlobalTotals<K>().v[f].fetch_add(d, std::memory_order_relaxed);
+        if (f == K::kMoved) detail::tl_moved += d;
+    }
+    void Max(int f, uint64_t x) const {
+        if (x > v_[f]) v_[f] = x;
+        detail::AtomicMax(detail::GlobalTotals<K>().v[f], x);
+    }
+    Snapshot<K> Stats() const {
+        Snapshot<K> s;
+        for (int f = 0; f < K::N; ++f) s.v[f] = v_[f];
+        return s;
+    }
+};
+#else
+template<class K>
+class Counters {
+public:
+    void Add(int, uint64_t = 1) const {}
+    void Max(int, uint64_t) const {}
+    Snapshot<K> Stats() const { return {}; }
+};
+#endif
+
+/* последовательность скопировала n элементов целиком (immutable-операция,
+   запись в общий буфер после GetSubsequence / Clone) */
+template<class T>
+void CountCopy(const Counters<SequenceKind>& c, size_t n) {
+    c.Add(SequenceKind::FullCopies);
+    c.Add(SequenceKind::BytesCopied, n * sizeof(T));
+}
+
+/* снятие элемента адаптером: если хранилище при этом перекладывало байты
+   (сдвиг хвоста, копия общего буфера) — это перестройка, а не O(1) */
+template<class F>
+auto CountPop(const Counters<AdapterKind>& c, F pop) {
+    if constexpr (kEnabled) {
+        uint64_t before = detail::tl_moved;
+        auto v = pop();
+        c.Add(AdapterKind::Pops);
+        if (detail::tl_moved != before) c.Add(AdapterKind::RebuildingPops);
+        return v;
+    } else {
+        return pop();
+    }
+}
+
+} // namespace stats
@@ -0,0 +1,152 @@
+#pragma once
+#include "ConcurrentQueue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Пул потоков с воровством задач.
+   ThreadPool(n): n-1 фоновых потоков + поток, вызвавший ParallelFor, который
+   тоже выполняет задачи, пока ждёт. У каждого потока своя дека: владелец
+   берёт с хвоста (свежие задачи ещё в кэше), воры — с головы. */
+
+/* размер куска для ParallelFor: не меньше MinChunk, и примерно
+   TasksPerThread кусков на поток, чтобы было что воровать */
+struct Grain {
+    size_t MinChunk       = 2048;
+    size_t TasksPerThread = 4;
+
+    static Grain Fixed(size_t chunk) { return { chunk, 0 }; }
+    size_t ChunkFor(size_t n, size_t threads) const {
+        size_t c = MinChunk ? MinChunk : 1;
+        if (TasksPerThread) c = std::max(c, (n + threads * TasksPerThread - 1) / (threads * TasksPerThread));
+        return c;
+    }
+};
+
+class ThreadPool {
+    using Task = std::function<void()>;
+    struct alignas(kCacheLineSize) WorkQueue {
+        std::mutex m;
+        std::deque<Task> q;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;   // [0, n-1) — воркеры, n-1 — внешние потоки
+    std::vector<std::thread> threads_;
+    std::mutex sleepM_;
+    std::condition_variable sleepCv_;
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> rr_{0};
+    bool stop_ = false;
+
+    // индекс очереди текущего потока в этом пуле (или внешний)
+    static std::pair<const ThreadPool*, size_t>& self() {
+        thread_local std::pair<const ThreadPool*, size_t> s{ nullptr, 0 };
+        return s;
+    }
+    size_t myQueue() const { return self().first == this ? self().second : queues_.size() - 1; }
+
+    bool popFrom(size_t i, bool back, Task& t) {
+        WorkQueue& w = *queues_[i];
+        std::lock_guard<std::mutex> lk(w.m);
+        if (w.q.empty()) return false;
+        if (back) { t = std::move(w.q.back());  w.q.pop_back(); }
+        else      { t = std::move(w.q.front()); w.q.pop_front(); }
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void workerLoop(size_t i) {
+        self() = { this, i };
+        for (;;) {
+            if (TryRunOne()) continue;
+            std::unique_lock<std::mutex> lk(sleepM_);
+            sleepCv_.wait(lk, [this] { return stop_ || pending_.load(std::memory_order_relaxed) > 0; });
+            if (stop_) return;
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency()) {
+        if (!threads) threads = 1;
+        for (size_t i = 0; i < threads; ++i) queues_.emplace_back(new WorkQueue);
+        for (size_t i = 0; i + 1 < threads; ++i) threads_.emplace_back([this, i] { workerLoop(i); });
+    }
+    ~ThreadPool() {
+        { std::lock_guard<std::mutex> lk(sleepM_); stop_ = true; }
+        sleepCv_.notify_all();
+        for (auto& t : threads_) t.join();
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // общий пул на всё железо
+    static ThreadPool& Default() { static ThreadPool pool; return pool; }
+
+    size_t Size() const { return queues_.size(); }
+
+    void Submit(Task t) {
+        size_t i = self().first == this ? self().second
+                                         : rr_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard<std::mutex> lk(queues_[i]->m);
+            queues_[i]->q.push_back(std::move(t));
+        }
+        { std::lock_guard<std::mutex> lk(sleepM_); pending_.fetch_add(1, std::memory_order_relaxed); }
+        sleepCv_.notify_one();
+    }
+
+    // своя задача с хвоста, иначе ворует у остальных с головы
+    bool TryRunOne() {
+        if (!pending_.load(std::memory_order_relaxed)) return false;
+        const size_t me = myQueue(), n = queues_.size();
+        Task t;
+        bool got = popFrom(me, true, t);
+        for (size_t k = 1; !got && k < n; ++k) got = popFrom((me + k) % n, false, t);
+        if (!got) return false;
+        t();
+        return true;
+    }
+
+    /* f(begin, end) по кускам [0, n) длины chunk; ждёт завершения, сам выполняет
+       задачи, пока ждёт (поэтому вложенные вызовы не блокируют пул).
+       Первое исключение из f пробрасывается после завершения всех кусков */
+    template<class F>
+    void ParallelFor(size_t n, size_t chunk, F f) {
+        if (!n) return;
+        if (!chunk) chunk = 1;
+        const size_t tasks = (n + chunk - 1) / chunk;
+        if (tasks == 1 || Size() == 1) {
+            for (size_t b = 0; b < n; b += chunk) f(b, std::min(n, b + chunk));
+            return;
+        }
+        struct Group {
+            std::atomic<size_t> left;
+            std::mutex errM;
+            std::exception_ptr err;
+        } g;
+        g.left.store(tasks, std::memory_order_relaxed);
+        auto run = [&g, &f, n, chunk](size_t b) {
+            try { f(b, std::min(n, b + chunk)); }
+            catch (...) {
+                std::lock_guard<std::mutex> lk(g.errM);
+                if (!g.err) g.err = std::current_exception();
+            }
+            g.left.fetch_sub(1, std::memory_order_acq_rel);
+        };
+        for (size_t t = tasks; t-- > 1;) Submit([&run, t, chunk] { run(t * chunk); });
+        run(0);
+        while (g.left.load(std::memory_order_acquire))
+            if (!TryRunOne()) std::this_thread::yield();
+        if (g.err) std::rethrow_exception(g.err);
+    }
+    template<class F>
+    void ParallelFor(size_t n, Grain grain, F f) { ParallelFor(n, grain.ChunkFor(n, Size()), f); }
+};
@@ -0,0 +1,278 @@
+#pragma once
+#include "BoundsCheck.hpp"
+#include "ChunkCursor.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Развёрнутый список: двусвязные узлы, в каждом — блок до B элементов.
+   Обход идёт по непрерывным блокам, Get(i) пропускает узлы целиком (O(n/B)).
+   При вставке в полный узел он делится пополам, при удалении полупустые
+   соседи сливаются. API повторяет LinkedList — годится как List для
+   MutableListSequence/ImmutableListSequence. */
+template<typename T, size_t B = std::max<size_t>(8, 256/sizeof(T))>
+class UnrolledLinkedList {
+    static_assert(B >= 2, "UnrolledLinkedList: block must hold >= 2 elements");
+
+    struct Node {
+        Node*  prev  = nullptr;
+        Node*  next  = nullptr;
+        size_t count = 0;
+        alignas(T) unsigned char raw[B*sizeof(T)];
+
+        T*       items()       { return std::launder(reinterpret_cast<T*>(raw)); }
+        const T* items() const { return std::launder(reinterpret_cast<const T*>(raw)); }
+        ~Node(){ std::destroy(items(), items()+count); }
+
+        // сдвиг [from, count) на d позиций вправо; [from, from+d) становятся «сырыми»
+        void openGap(size_t from,size_t d){
+            T* a = items();
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                std::memmove(static_cast<void*>(a+from+d), a+from, (count-from)*sizeof(T));
+            } else {
+                for(size_t k=count;k>from;--k){
+                    ::new (static_cast<void*>(a+k-1+d)) T(std::move(a[k-1]));
+                    a[k-1].~T();
+                }
+            }
+        }
+        // обратно к openGap: хвост [from+d, count+d) возвращается на from, [from, from+d) сырые
+        void shiftBack(size_t from,size_t d){
+            T* a = items();
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                std::memmove(static_cast<void*>(a+from), a+from+d, (count-from)*sizeof(T));
+            } else {
+                for(size_t k=from;k<count;++k){
+                    ::new (static_cast<void*>(a+k)) T(std::move(a[k+d]));
+                    a[k+d].~T();
+                }
+            }
+        }
+        // удалить [from, from+d), хвост сдвигается влево
+        void closeGap(size_t from,size_t d){
+            std::destroy(items()+from, items()+from+d);
+            count -= d;
+            shiftBack(from, d);
+        }
+        // перенести [from, count) в конец узла dst
+        void moveTail(size_t from,Node* dst){
+            T* a = items(); T* b = dst->items();
+            for(size_t k=from;k<count;++k){
+                ::new (static_cast<void*>(b+dst->count++)) T(std::move(a[k]));
+                a[k].~T();
+            }
+            count = from;
+        }
+    };
+
+    Node* head_ = nullptr;
+    Node* tail_ = nullptr;
+    size_t len_ = 0;
+
+    void range_check(size_t i) const { if (i >= len_) detail::ThrowIndexOutOfRange(i, len_, "length"); }
+    // узел и смещение элемента i; идём с ближнего конца
+    std::pair<Node*,size_t> locate(size_t i) const {
+        if (i < len_/2) {
+            Node* p = head_;
+            while (i >= p->count) { i -= p->count; p = p->next; }
+            return {p, i};
+        }
+        Node* p = tail_; size_t base = len_ - p->count;
+        while (i < base) { p = p->prev; base -= p->count; }
+        return {p, i-base};
+    }
+    Node* insertAfter(Node* at){                 // at == nullptr — в начало
+        Node* n = new Node;
+        n->prev = at;
+        n->next = at ? at->next : head_;
+        (n->next ? n->next->prev : tail_) = n;
+        (at ? at->next : head_) = n;
+        return n;
+    }
+    void unlink(Node* n){
+        (n->prev ? n->prev->next : head_) = n->next;
+        (n->next ? n->next->prev : tail_) = n->prev;
+        delete n;
+    }
+    // готовый элемент в позицию off узла n; если перенос бросит — щель закрывается
+    T& place(Node* n,size_t off,T&& v){
+        n->openGap(off, 1);
+        T* p;
+        try { p = ::new (static_cast<void*>(n->items()+off)) T(std::move(v)); }
+        catch (...) { n->shiftBack(off, 1); if(!n->count) unlink(n); throw; }
+        ++n->count; ++len_;
+        return *p;
+    }
+    // слить n со следующим, если оба заполнены меньше чем наполовину
+    void maybeMerge(Node* n){
+        if (!n) return;
+        if (n->count == 0) { unlink(n); return; }
+        Node* nx = n->next;
+        if (nx && n->count + nx->count <= B/2) { nx->moveTail(0, n); unlink(nx); }
+    }
+
+public:
+    /* --- ctors/dtor --- */
+    UnrolledLinkedList() = default;
+    UnrolledLinkedList(const T* src,size_t n){ for(size_t i=0;i<n;++i) Append(src[i]); }
+
+    UnrolledLinkedList(const UnrolledLinkedList& o){ for(const auto& v:o) Append(v); }
+    UnrolledLinkedList& operator=(UnrolledLinkedList rhs){ swap(rhs); return *this; }
+
+    UnrolledLinkedList(UnrolledLinkedList&& o) noexcept { swap(o); }
+
+    ~UnrolledLinkedList(){ clear(); }
+
+    /* --- read --- */
+    size_t   GetLength() const { return len_; }
+    const T& GetFirst()  const {
+        if(!head_) throw std::out_of_range("GetFirst: empty list");
+        return head_->items()[0];
+    }
+    const T& GetLast()   const {
+        if(!tail_) throw std::out_of_range("GetLast: empty list");
+        return tail_->items()[tail_->count-1];
+    }
+    const T& Get(size_t idx) const {
+        range_check(idx);
+        auto [n, off] = locate(idx);
+        return n->items()[off];
+    }
+
+    /* --- блочный обход: по блоку за раз, c.node — следующий узел --- */
+    bool NextChunk(ChunkCursor& c,const T*& p,size_t& n) const {
+        const Node* node = c.pos ? static_cast<const Node*>(c.node) : head_;
+        if(!node) return false;
+        p = node->items(); n = node->count;
+        c.node = node->next; c.pos += n;
+        return true;
+    }
+
+    /* --- modify --- */
+    template<typename... A>
+    T& EmplaceBack(A&&... a){
+        if(!tail_ || tail_->count==B) insertAfter(tail_);
+        T* p = ::new (static_cast<void*>(tail_->items()+tail_->count)) T(std::forward<A>(a)...);
+        ++tail_->count; ++len_;
+        return *p;
+    }
+    // аргументы могут ссылаться на элементы, которые сдвиг или деление узла
+    // переложат, — элемент строится до них
+    template<typename... A>
+    T& EmplaceFront(A&&... a){
+        T v(std::forward<A>(a)...);
+        if(!head_ || head_->count==B) insertAfter(nullptr);
+        return place(head_, 0, std::move(v));
+    }
+    template<typename... A>
+    T& Emplace(size_t i,A&&... a){
+        if(i>len_) throw std::out_of_range("InsertAt: idx="+std::to_string(i));
+        if(i==len_) return EmplaceBack(std::forward<A>(a)...);
+        T v(std::forward<A>(a)...);
+        auto [n, off] = locate(i);
+        if(n->count==B){                         // делим полный узел пополам
+            Node* right = insertAfter(n);
+            n->moveTail(B/2, right);
+            if(off > B/2){ n = right; off -= B/2; }
+        }
+        return place(n, off, std::move(v));
+    }
+    void Append(const T& v){ EmplaceBack(v); }
+    void Append(T&& v)     { EmplaceBack(std::move(v)); }
+    void Prepend(const T& v){ EmplaceFront(v); }
+    void Prepend(T&& v)     { EmplaceFront(std::move(v)); }
+    void InsertAt(const T& v,size_t i){ Emplace(i, v); }
+    void InsertAt(T&& v,size_t i)     { Emplace(i, std::move(v)); }
+
+    /* --- removal --- */
+    T PopFront(){
+        if(!head_) throw std::out_of_range("PopFront: empty list");
+        return RemoveAt(0);
+    }
+    T PopBack(){
+        if(!tail_) throw std::out_of_range("PopBack: empty list");
+        T v = std::move(tail_->items()[tail_->count-1]);
+        tail_->closeGap(tail_->count-1, 1); --len_;
+        if(!tail_->count) unlink(tail_);
+        return v;
+    }
+    T RemoveAt(size_t i){
+        range_check(i);
+        auto [n, off] = locate(i);
+        T v = std::move(n->items()[off]);
+        n->closeGap(off, 1); --len_;
+        maybeMerge(n);
+        return v;
+    }
+    void Erase(size_t l,size_t r){          // [l, r]
+        if(l>r||r>=len_) throw std::out_of_range("Erase: bad range");
+        size_t cnt = r-l+1;
+        auto [n, off] = locate(l);
+        Node* first = n->prev;
+        while(cnt){
+            size_t take = std::min(cnt, n->count-off);
+            n->closeGap(off, take);
+            cnt -= take; len_ -= take;
+            Node* nx = n->next;
+            if(!n->count) unlink(n);
+            n = nx; off = 0;
+        }
+        maybeMerge(first ? first : head_);
+    }
+
+    /* --- сортировка: блоки переносятся в массив, сортируются устойчиво и
+       возвращаются на те же места; узлы не перестраиваются --- */
+    template<typename Cmp>
+    void Sort(Cmp cmp){
+        if(len_<2) return;
+        std::vector<T> tmp;
+        tmp.reserve(len_);
+        for(Node* n=head_;n;n=n->next) std::move(n->items(), n->items()+n->count, std::back_inserter(tmp));
+        std::stable_sort(tmp.begin(), tmp.end(), cmp);
+        auto src = tmp.begin();
+        for(Node* n=head_;n;n=n->next) { std::move(src, src+n->count, n->items()); src += n->count; }
+    }
+
+    UnrolledLinkedList* GetSubList(size_t l,size_t r) const{
+        if(l>r||r>=len_) throw std::out_of_range("GetSubList: bad range");
+        auto* res = new UnrolledLinkedList;
+        auto [n, off] = locate(l);
+        for(size_t k=l;k<=r;++k){
+            res->Append(n->items()[off]);
+            if(++off==n->count){ n=n->next; off=0; }
+        }
+        return res;
+    }
+    UnrolledLinkedList* Concat(const UnrolledLinkedList* o) const{
+        auto* res = new UnrolledLinkedList(*this);
+        for(const auto& v:*o) res->Append(v);
+        return res;
+    }
+
+    /* --- iterators: узел + позиция в блоке --- */
+    template<typename R, typename N>
+    class iter{
+        N* n; size_t i;
+    public:
+        iter(N* node,size_t idx):n(node),i(idx){}
+        iter& operator++(){ if(++i==n->count){ n=n->next; i=0; } return *this; }
+        bool operator!=(const iter& o)const{ return n!=o.n || i!=o.i; }
+        R& operator*() const { return n->items()[i]; }
+    };
+    using it  = iter<T, Node>;
+    using cit = iter<const T, const Node>;
+
+    it  begin(){ return it(head_,0); }  it  end(){ return it(nullptr,0); }
+    cit begin() const { return cit(head_,0); }  cit end() const { return cit(nullptr,0); }
+
+private:
+    void clear(){ while(head_){ Node* n=head_; head_=head_->next; delete n; } tail_=nullptr; len_=0; }
+    void swap(UnrolledLinkedList& o){ std::swap(head_,o.head_); std::swap(tail_,o.tail_); std::swap(len_,o.len_); }
+};
@@ -1,8 +1,20 @@
 #pragma once
 #include "MutableArraySequence.hpp"
+#include "ImmutableArraySequence.hpp"
+#include "SequenceSlice.hpp"
+#include "RopeSequence.hpp"
+#include "SmallArraySequence.hpp"
+#include "SimdKernels.hpp"
+#include "ThreadPool.hpp"
+#include "Sort.hpp"
+#include "RadixSort.hpp"
 #include <algorithm>
 #include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include <string>
 
 /* ---------- zip / unzip ---------- */
@@ -13,7 +25,9 @@ Zip(const Sequence<A>& left, const Sequence<B>& right)
     using P = std::pair<A,B>;
     auto res = SeqUPtr<P>(new MutableArraySequence<P>);
     size_t n = std::min(left.GetLength(), right.GetLength());
-    for (size_t i=0;i<n;++i) res->Append({ left.Get(i), right.Get(i) });
+    auto li = left.begin();
+    auto ri = right.begin();
+    for (size_t i=0;i<n;++i, ++li, ++ri) res->Append({ *li, *ri });
     return res;
 }
 
@@ -23,10 +37,10 @@ Unzip(const Sequence< std::pair<A,B> >& src)
 {
     auto l = SeqUPtr<A>(new MutableArraySequence<A>);
     auto r = SeqUPtr<B>(new MutableArraySequence<B>);
-    for (size_t i=0;i<src.GetLength();++i) {
-        l->Append(src.Get(i).first);
-        r->Append(src.Get(i).second);
-    }
+    src.ForEach([&](const std::pair<A,B>& v) {
+        l->Append(v.first);
+        r->Append(v.second);
+    });
     return { std::move(l), std::move(r) };
 }
 
@@ -38,17 +52,100 @@ Split(const Sequence<T>& src, Pred delim)
     using Sub = SeqUPtr<T>;
     auto res = SeqUPtr<Sub>(new MutableArraySequence<Sub>);
     auto cur = SeqUPtr<T>(new MutableArraySequence<T>);
-    for (size_t i=0;i<src.GetLength();++i) {
-        const T& v = src.Get(i);
+    src.ForEach([&](const T& v) {
         if (delim(v)) {
             if (cur->GetLength()) res->Append(std::move(cur));
             cur = SeqUPtr<T>(new MutableArraySequence<T>);
         } else cur->Append(v);
-    }
+    });
     if (cur->GetLength()) res->Append(std::move(cur));
     return res;
 }
 
+/* Split<N>: куски хранятся по значению в SmallArraySequence<T,N> —
+   куски длиной <= N не требуют ни одной аллокации */
+template<size_t N, typename T, typename Pred>
+SeqUPtr< SmallArraySequence<T,N> >
+Split(const Sequence<T>& src, Pred delim)
+{
+    using Sub = SmallArraySequence<T,N>;
+    auto res = SeqUPtr<Sub>(new MutableArraySequence<Sub>);
+    Sub cur;
+    src.ForEach([&](const T& v) {
+        if (delim(v)) {
+            if (cur.GetLength()) res->Append(cur);
+            cur = Sub();
+        } else cur.Append(v);
+    });
+    if (cur.GetLength()) res->Append(cur);
+    return res;
+}
+
+/* ---------- views: срезы без копирования ---------- */
+namespace detail {
+    // буфер массива-источника любой из политик проверки индекса
+    template<typename... Arr, typename T>
+    bool ShareOfArray(const Sequence<T>& s, SharedArray<T>& buf)
+    {
+        return ((dynamic_cast<const Arr*>(&s) ? (buf = static_cast<const Arr&>(s).Buffer(), true) : false) || ...);
+    }
+    // общий буфер массива-источника; false — источник не массив
+    template<typename T>
+    bool ShareOf(const Sequence<T>& s, SharedArray<T>& buf, size_t& off, bool& readOnly)
+    {
+        if (ShareOfArray<MutableArraySequence<T, CheckedBounds>, MutableArraySequence<T, AssertBounds>,
+                         MutableArraySequence<T, UncheckedBounds>>(s, buf)) { off = 0; readOnly = false; return true; }
+        if (ShareOfArray<ImmutableArraySequence<T, CheckedBounds>, ImmutableArraySequence<T, AssertBounds>,
+                         ImmutableArraySequence<T, UncheckedBounds>>(s, buf)) { off = 0; readOnly = true; return true; }
+        if (auto* v = dynamic_cast<const SequenceSlice<T>*>(&s)) {
+            buf = v->Buffer(); off = v->Offset(); readOnly = v->IsReadOnly(); return true;
+        }
+        return false;
+    }
+    // массив-источник как есть или его единственная копия
+    template<typename T>
+    void ShareOrCopy(const Sequence<T>& s, SharedArray<T>& buf, size_t& off, bool& readOnly)
+    {
+        if (ShareOf(s, buf, off, readOnly)) return;
+        DynamicArray<T> d;
+        d.Reserve(s.GetLength());
+        s.ForEach([&](const T& v) { d.PushBack(v); });
+        buf = SharedArray<T>(std::move(d)); off = 0; readOnly = false;
+    }
+}
+
+/* окно [start, start+cnt) источника; для массивов — O(1) */
+template<typename T>
+SeqUPtr<T> SliceView(const Sequence<T>& src, size_t start, size_t cnt)
+{
+    if (start + cnt > src.GetLength()) throw std::out_of_range("SliceView: start+cnt overflow");
+    SharedArray<T> buf; size_t off = 0; bool ro = false;
+    if (!detail::ShareOf(src, buf, off, ro)) {
+        if (!cnt) return SeqUPtr<T>(new MutableArraySequence<T>);
+        return src.GetSubsequence(start, start + cnt - 1);
+    }
+    return SeqUPtr<T>(new SequenceSlice<T>(std::move(buf), off + start, cnt, ro));
+}
+
+/* SplitView: куски — срезы одного буфера (для не-массивов — одной его копии) */
+template<typename T, typename Pred>
+SeqUPtr< SequenceSlice<T> >
+SplitView(const Sequence<T>& src, Pred delim)
+{
+    using Sub = SequenceSlice<T>;
+    SharedArray<T> buf; size_t off = 0; bool ro = false;
+    detail::ShareOrCopy(src, buf, off, ro);
+    auto res = SeqUPtr<Sub>(new MutableArraySequence<Sub>);
+    const T* p = buf.Read().begin() + off;
+    size_t n = src.GetLength(), from = 0;
+    for (size_t i = 0; i <= n; ++i) {
+        if (i < n && !delim(p[i])) continue;
+        if (i > from) res->Append(Sub(buf, off + from, i - from, ro));
+        from = i + 1;
+    }
+    return res;
+}
+
 /* ---------- slice ---------- */
 template<typename T>
 SeqUPtr<T> Slice(const Sequence<T>& src,int start,size_t cnt,
@@ -61,11 +158,35 @@ SeqUPtr<T> Slice(const Sequence<T>& src,int start,size_t cnt,
     if (start + static_cast<int>(cnt) > n)
         throw std::out_of_range("Slice: start+cnt overflow");
 
-    auto res = SeqUPtr<T>(new MutableArraySequence<T>);
-    for (int i=0;i<start;++i) res->Append(src.Get(i));
-    if (repl) for (size_t i=0;i<repl->GetLength();++i) res->Append(repl->Get(i));
-    for (int i=start+static_cast<int>(cnt); i<n; ++i) res->Append(src.Get(i));
-    return res;
+    size_t from = static_cast<size_t>(start), to = from + cnt, i = 0;
+    if (auto* rope = dynamic_cast<const RopeSequence<T>*>(&src)) {     // O(log n): split + join
+        auto res = std::make_unique<RopeSequence<T>>(*rope);
+        res->Splice(from, cnt, repl);
+        return res;
+    }
+    SharedArray<T> buf; size_t off = 0; bool ro = false;
+    if (!repl && (from == 0 || to == static_cast<size_t>(n)) && detail::ShareOf(src, buf, off, ro)) {
+        // остаток массива непрерывен — срез; изменяемый, как и обычный результат (копия при записи)
+        size_t l = from == 0 ? to : 0;
+        return SeqUPtr<T>(new SequenceSlice<T>(std::move(buf), off + l, static_cast<size_t>(n) - cnt));
+    }
+
+    // результат собирается кусками: [0, from) + repl + [to, n), одна аллокация
+    DynamicArray<T> d;
+    d.Reserve(static_cast<size_t>(n) - cnt + (repl ? repl->GetLength() : 0));
+    auto putRepl = [&] {
+        repl->ForEachChunk([&d](const T* p, size_t k) { d.AppendRange(p, p+k); return true; });
+    };
+    src.ForEachChunk([&](const T* p, size_t k) {
+        size_t e = i + k;
+        if (i < from) d.AppendRange(p, p + (std::min(e, from) - i));
+        if (repl && i <= from && from < e) putRepl();
+        if (e > to) d.AppendRange(p + (std::max(i, to) - i), p + k);
+        i = e;
+        return true;
+    });
+    if (from == i && repl) putRepl();                 // вставка в самый конец
+    return SeqUPtr<T>(new MutableArraySequence<T>(std::move(d)));
 }
 
 /* ---------- from / fold / free-where / free-find ---------- */
@@ -86,3 +207,237 @@ SeqUPtr<T> Where(const Sequence<T>& seq, P p) { return seq.Where(p); }
 
 template<typename T, typename P>
 T Find(const Sequence<T>& seq, P p) { return seq.Find(p); }
+
+/* ---------- численные алгоритмы на SIMD-ядрах ----------
+   Ядра из SimdKernels.hpp применяются к каждому куску ForEachChunk.
+   Предикат/отображение должны быть обобщёнными (принимать и T, и вектор T) */
+template<typename T>
+simd::SumType<T> Sum(const Sequence<T>& seq)
+{
+    simd::SumType<T> s = 0;
+    seq.ForEachChunk([&](const T* p, size_t n) { s += simd::Sum(p, n); return true; });
+    return s;
+}
+
+template<typename T>
+T Min(const Sequence<T>& seq)
+{
+    if (!seq.GetLength()) throw std::out_of_range("Min: empty");
+    T best = seq.GetFirst();
+    seq.ForEachChunk([&](const T* p, size_t n) { best = std::min(best, simd::Min(p, n)); return true; });
+    return best;
+}
+
+template<typename T>
+T Max(const Sequence<T>& seq)
+{
+    if (!seq.GetLength()) throw std::out_of_range("Max: empty");
+    T best = seq.GetFirst();
+    seq.ForEachChunk([&](const T* p, size_t n) { best = std::max(best, simd::Max(p, n)); return true; });
+    return best;
+}
+
+template<typename T, typename P>
+size_t CountIfSimd(const Sequence<T>& seq, P p)
+{
+    size_t cnt = 0;
+    seq.ForEachChunk([&](const T* q, size_t n) { cnt += simd::CountIf(q, n, p); return true; });
+    return cnt;
+}
+
+template<typename T, typename F>
+SeqUPtr<T> MapSimd(const Sequence<T>& seq, F f)
+{
+    DynamicArray<T> out;
+    out.Reserve(seq.GetLength());                   // ядро пишет в сырой запас, без обнуления
+    size_t at = 0;
+    seq.ForEachChunk([&](const T* p, size_t n) { simd::Transform(p, n, out.data() + at, f); at += n; return true; });
+    out.CommitBack(at);
+    return SeqUPtr<T>(new MutableArraySequence<T>(std::move(out)));
+}
+
+template<typename T, typename P>
+SeqUPtr<T> WhereSimd(const Sequence<T>& seq, P p)
+{
+    DynamicArray<T> out;
+    out.Reserve(seq.GetLength());
+    size_t at = 0;
+    seq.ForEachChunk([&](const T* q, size_t n) { at += simd::Compact(q, n, out.data() + at, p); return true; });
+    out.CommitBack(at);
+    return SeqUPtr<T>(new MutableArraySequence<T>(std::move(out)));
+}
+
+/* индекс первого подходящего элемента или GetLength() */
+template<typename T, typename P>
+size_t FindIndexSimd(const Sequence<T>& seq, P p)
+{
+    size_t base = 0, hit = seq.GetLength();
+    seq.ForEachChunk([&](const T* q, size_t n) {
+        size_t k = simd::FindFirst(q, n, p);
+        if (k < n) { hit = base + k; return false; }
+        base += n;
+        return true;
+    });
+    return hit;
+}
+
+/* ---------- параллельные Map / Reduce / Where / FlatMap ----------
+   Работают на ThreadPool (по умолчанию — общий на всё железо); Grain задаёт
+   размер куска. Последовательность раскладывается на куски NextChunk, и
+   диапазон индексов делится между задачами — для массивов это один кусок */
+namespace detail {
+    template<typename T>
+    struct ChunkSpans {
+        std::vector<const T*> ptr;
+        std::vector<size_t>   start;        // глобальный индекс начала куска
+        size_t total = 0;
+
+        explicit ChunkSpans(const Sequence<T>& s) {
+            s.ForEachChunk([this](const T* p, size_t n) {
+                ptr.push_back(p); start.push_back(total); total += n;
+                return true;
+            });
+        }
+        // g(const T* p, size_t k, size_t at) для кусков, покрывающих [b, e)
+        template<typename G>
+        void Visit(size_t b, size_t e, G g) const {
+            size_t c = std::upper_bound(start.begin(), start.end(), b) - start.begin() - 1;
+            for (; b < e; ++c) {
+                size_t end = c + 1 < start.size() ? start[c + 1] : total;
+                size_t k = std::min(e, end) - b;
+                g(ptr[c] + (b - start[c]), k, b);
+                b += k;
+            }
+        }
+    };
+
+    // диапазоны, которые задачи уже построили в сырой памяти base; если задача
+    // бросила, построенное разрушается (для тривиально разрушаемых U учёта нет)
+    template<typename U>
+    class BuiltRanges {
+        U* base_;
+        std::mutex m_;
+        std::vector<std::pair<size_t, size_t>> r_;
+        bool done_ = false;
+    public:
+        explicit BuiltRanges(U* base) : base_(base) {}
+        ~BuiltRanges() { if (!done_) for (auto [b, e] : r_) std::destroy(base_ + b, base_ + e); }
+        void Add(size_t b, size_t e) {
+            if constexpr (!std::is_trivially_destructible_v<U>) {
+                std::lock_guard<std::mutex> lk(m_);
+                r_.emplace_back(b, e);
+            }
+        }
+        void Done() { done_ = true; }
+    };
+
+    // склейка буферов задач: префиксные суммы размеров, затем параллельный перенос
+    // прямо в сырой запас результата — без конструктора по умолчанию и двойной записи
+    template<typename U>
+    SeqUPtr<U> MergeBuffers(std::vector<std::vector<U>>& bufs, ThreadPool& pool)
+    {
+        std::vector<size_t> at(bufs.size() + 1, 0);
+        for (size_t i = 0; i < bufs.size(); ++i) at[i + 1] = at[i] + bufs[i].size();
+        DynamicArray<U> out;
+        out.Reserve(at.back());
+        U* o = out.data();
+        BuiltRanges<U> built(o);
+        pool.ParallelFor(bufs.size(), size_t(1), [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                std::uninitialized_move(bufs[i].begin(), bufs[i].end(), o + at[i]);
+                built.Add(at[i], at[i + 1]);
+            }
+        });
+        built.Done();
+        out.CommitBack(at.back());
+        return SeqUPtr<U>(new MutableArraySequence<U>(std::move(out)));
+    }
+}
+
+template<typename U, typename T, typename F>
+SeqUPtr<U> ParallelMap(const Sequence<T>& seq, F f,
+                       ThreadPool& pool = ThreadPool::Default(), Grain grain = Grain())
+{
+    detail::ChunkSpans<T> spans(seq);
+    DynamicArray<U> out;
+    out.Reserve(spans.total);                       // результат f строится сразу на месте
+    U* o = out.data();
+    detail::BuiltRanges<U> built(o);
+    pool.ParallelFor(spans.total, grain, [&](size_t b, size_t e) {
+        size_t i = b;
+        try {
+            spans.Visit(b, e, [&](const T* p, size_t k, size_t) {
+                for (size_t j = 0; j < k; ++j, ++i) ::new (static_cast<void*>(o + i)) U(f(p[j]));
+            });
+        } catch (...) { std::destroy(o + b, o + i); throw; }
+        built.Add(b, e);
+    });
+    built.Done();
+    out.CommitBack(spans.total);
+    return SeqUPtr<U>(new MutableArraySequence<U>(std::move(out)));
+}
+
+/* reduce(U, T) сворачивает кусок, combine(U, U) склеивает куски по порядку,
+   так что достаточно ассоциативности; identity — нейтральный для combine */
+template<typename T, typename U, typename R, typename C>
+U ParallelReduce(const Sequence<T>& seq, U identity, R reduce, C combine,
+                 ThreadPool& pool = ThreadPool::Default(), Grain grain = Grain())
+{
+    detail::ChunkSpans<T> spans(seq);
+    if (!spans.total) return identity;
+    const size_t chunk = grain.ChunkFor(spans.total, pool.Size());
+    std::vector<U> part((spans.total + chunk - 1) / chunk, identity);
+    pool.ParallelFor(spans.total, chunk, [&](size_t b, size_t e) {
+        U acc = identity;
+        spans.Visit(b, e, [&](const T* p, size_t k, size_t) {
+            for (size_t i = 0; i < k; ++i) acc = reduce(acc, p[i]);
+        });
+        part[b / chunk] = std::move(acc);
+    });
+    U res = std::move(part[0]);
+    for (size_t i = 1; i < part.size(); ++i) res = combine(res, part[i]);
+    return res;
+}
+template<typename T, typename R>
+T ParallelReduce(const Sequence<T>& seq, T identity, R op,
+                 ThreadPool& pool = ThreadPool::Default(), Grain grain = Grain())
+{
+    return ParallelReduce(seq, identity, op, op, pool, grain);
+}
+
+/* порядок сохраняется: у каждой задачи свой буфер, потом MergeBuffers */
+template<typename T, typename P>
+SeqUPtr<T> ParallelWhere(const Sequence<T>& seq, P pred,
+                         ThreadPool& pool = ThreadPool::Default(), Grain grain = Grain())
+{
+    detail::ChunkSpans<T> spans(seq);
+    const size_t chunk = grain.ChunkFor(spans.total, pool.Size());
+    std::vector<std::vector<T>> bufs((spans.total + chunk - 1) / chunk);
+    pool.ParallelFor(spans.total, chunk, [&](size_t b, size_t e) {
+        auto& buf = bufs[b / chunk];
+        spans.Visit(b, e, [&](const T* p, size_t k, size_t) {
+            for (size_t i = 0; i < k; ++i) if (pred(p[i])) buf.push_back(p[i]);
+        });
+    });
+    return detail::MergeBuffers(bufs, pool);
+}
+
+/* f(const T&) -> SeqUPtr<U>, как у Sequence::FlatMap */
+template<typename U, typename T, typename F>
+SeqUPtr<U> ParallelFlatMap(const Sequence<T>& seq, F f,
+                           ThreadPool& pool = ThreadPool::Default(), Grain grain = Grain())
+{
+    detail::ChunkSpans<T> spans(seq);
+    const size_t chunk = grain.ChunkFor(spans.total, pool.Size());
+    std::vector<std::vector<U>> bufs((spans.total + chunk - 1) / chunk);
+    pool.ParallelFor(spans.total, chunk, [&](size_t b, size_t e) {
+        auto& buf = bufs[b / chunk];
+        spans.Visit(b, e, [&](const T* p, size_t k, size_t) {
+            for (size_t i = 0; i < k; ++i) {
+                auto sub = f(p[i]);
+                sub->ForEach([&](const U& u) { buf.push_back(u); });
+            }
+        });
+    });
+    return detail::MergeBuffers(bufs, pool);
+}
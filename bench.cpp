@@ -0,0 +1,1523 @@
+// bench.cpp — замеры времени для контейнеров.
+// Сборка: g++ -std=c++17 -O2 -pthread -Wno-psabi bench.cpp -o bench && ./bench > bench_output.txt
+// Разделы по имени: ./bench --list; ./bench --only suite --max-n 100000000 --csv suite.csv
+// CSV / JSON (--csv, --json) — по строке на замер: ns/op, ops/s, allocs/op — для сравнения сборок.
+
+#include "Stack.hpp"
+#include "Queue.hpp"
+#include "Deque.hpp"
+#include "ConcurrentQueue.hpp"
+#include "PriorityQueue.hpp"
+#include "IndexedPriorityQueue.hpp"
+#include "DynamicArray.hpp"
+#include "SmallArraySequence.hpp"
+#include "algorithms.hpp"
+#include "LinkedList.hpp"
+#include "NodePool.hpp"
+#include "UnrolledLinkedList.hpp"
+#include "MutableListSequence.hpp"
+#include "ImmutableArraySequence.hpp"
+#include "PersistentArraySequence.hpp"
+#include "RopeSequence.hpp"
+#include "ImmutableListSequence.hpp"
+#include "Sort.hpp"
+#include "RadixSort.hpp"
+#include "Stats.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <deque>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <functional>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <random>
+#include <mutex>
+#include <queue>
+#include <stack>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// ----------------- 1) Утилиты -------------------
+
+// счётчик вызовов operator new во всей программе; noinline — чтобы GCC
+// не сопоставлял встроенные malloc/free с new/delete (-Wmismatched-new-delete)
+static std::atomic<size_t> g_allocs{0};
+static size_t g_lastAllocs = 0;          // аллокаций за последний MeasureMs
+
+__attribute__((noinline)) void* operator new(size_t n) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+template<class F>
+double MeasureMs(F f) {
+    size_t a0 = g_allocs.load();
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    g_lastAllocs = g_allocs.load() - a0;
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// строка для --csv / --json; аллокации — за последний MeasureMs
+struct Result {
+    std::string section, name, type;
+    size_t size, ops;
+    double ms, allocsPerOp;
+};
+static std::vector<Result> g_results;
+static const char* g_section = "";       // задаёт main перед каждым разделом
+static const char* g_type    = "";       // тип элемента в сводном прогоне
+
+// size — размер контейнера, если он не равен числу операций
+void Report(const char* name, size_t n, double ms, size_t size = 0) {
+    std::printf("%-28s n=%-9zu %10.2f ms %8.2f ns/op\n", name, n, ms, ms * 1e6 / n);
+    g_results.push_back({ g_section, name, g_type, size ? size : n, n, ms, n ? double(g_lastAllocs) / n : 0.0 });
+}
+
+static volatile long long g_sink = 0;   // не даём оптимизатору выкинуть результат
+
+template<class F>
+void ReportWithAllocs(const char* name, size_t n, F f) {
+    Report(name, n, MeasureMs(f));
+    std::printf("%-28s %.3f allocs/op\n", "", g_results.back().allocsPerOp);
+}
+
+// ----------------- 2) Слив адаптеров: время на элемент не должно расти с n -------------------
+
+void BenchDrain() {
+    for (size_t n : {250000u, 500000u, 1000000u}) {
+        Report("Stack push+pop", n, MeasureMs([n] {
+            Stack<int> s;
+            for (size_t i = 0; i < n; ++i) s.Push(int(i));
+            long long acc = 0;
+            while (s.Size()) acc += s.Pop();
+            g_sink += acc;
+        }));
+        Report("Queue enqueue+dequeue", n, MeasureMs([n] {
+            Queue<int> q;
+            for (size_t i = 0; i < n; ++i) q.Enqueue(int(i));
+            long long acc = 0;
+            while (q.Size()) acc += q.Dequeue();
+            g_sink += acc;
+        }));
+        Report("Deque pushback+popback", n, MeasureMs([n] {
+            Deque<int> d;
+            for (size_t i = 0; i < n; ++i) d.PushBack(int(i));
+            long long acc = 0;
+            while (d.Size()) acc += d.PopBack();
+            g_sink += acc;
+        }));
+        Report("Deque pushfront+popfront", n, MeasureMs([n] {
+            Deque<int> d;
+            for (size_t i = 0; i < n; ++i) d.PushFront(int(i));
+            long long acc = 0;
+            while (d.Size()) acc += d.PopFront();
+            g_sink += acc;
+        }));
+    }
+}
+
+// ----------------- 3) Очередь в установившемся режиме (1 вход / 1 выход) -------------------
+
+void BenchSteadyQueue() {
+    const size_t backlog = 1000000, ops = 4000000;
+    Report("Queue steady (1M backlog)", ops, MeasureMs([&] {
+        Queue<int> q;
+        for (size_t i = 0; i < backlog; ++i) q.Enqueue(int(i));
+        long long acc = 0;
+        for (size_t i = 0; i < ops; ++i) { acc += q.Dequeue(); q.Enqueue(int(i)); }
+        g_sink += acc;
+    }));
+}
+
+// ----------------- 4) Межпоточные очереди: P производителей, C потребителей -------------------
+
+template<class Q>
+double RunProducersConsumers(Q& q, int producers, int consumers, size_t total) {
+    return MeasureMs([&] {
+        std::vector<std::thread> ths;
+        size_t perProd = total / producers, perCons = total / consumers;
+        for (int p = 0; p < producers; ++p)
+            ths.emplace_back([&q, perProd] { for (size_t i = 0; i < perProd; ++i) q.Enqueue(int(i)); });
+        for (int c = 0; c < consumers; ++c)
+            ths.emplace_back([&q, perCons] {
+                long long acc = 0;
+                for (size_t i = 0; i < perCons; ++i) acc += q.Dequeue();
+                g_sink += acc;
+            });
+        for (auto& t : ths) t.join();
+    });
+}
+
+// Queue<T> под мьютексом — то, чем пользовались раньше
+template<class T>
+class LockedQueue {
+    Queue<T> q;
+    std::mutex m;
+public:
+    void Enqueue(const T& item) { std::lock_guard<std::mutex> g(m); q.Enqueue(item); }
+    T Dequeue() {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> g(m);
+                if (q.Size()) return q.Dequeue();
+            }
+            std::this_thread::yield();
+        }
+    }
+};
+
+void BenchConcurrentQueues() {
+    const size_t total = 4000000;
+    for (auto pc : {std::pair<int,int>{1, 1}, {2, 2}, {4, 4}}) {
+        char name[64];
+        if (pc.first == 1) {
+            SpscQueue<int> s(1 << 16);
+            std::snprintf(name, sizeof name, "SpscQueue %dP/%dC", pc.first, pc.second);
+            Report(name, total, RunProducersConsumers(s, 1, 1, total));
+        }
+        MpmcQueue<int> m(1 << 16);
+        std::snprintf(name, sizeof name, "MpmcQueue %dP/%dC", pc.first, pc.second);
+        Report(name, total, RunProducersConsumers(m, pc.first, pc.second, total));
+        LockedQueue<int> l;
+        std::snprintf(name, sizeof name, "mutex+Queue %dP/%dC", pc.first, pc.second);
+        Report(name, total, RunProducersConsumers(l, pc.first, pc.second, total));
+    }
+}
+
+// ----------------- 5) Дейкстра: бинарная куча с дублями против адресуемой d-арной -------------------
+
+struct Graph {
+    std::vector<size_t> start;                        // CSR: рёбра вершины v — [start[v], start[v+1])
+    std::vector<std::pair<int,int>> edges;            // (куда, вес)
+};
+
+Graph RandomGraph(int n, int degree, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> node(0, n - 1), weight(1, 1000);
+    Graph g;
+    g.start.resize(n + 1);
+    for (int v = 0; v < n; ++v) {
+        g.start[v] = g.edges.size();
+        for (int k = 0; k < degree; ++k) g.edges.push_back({node(rng), weight(rng)});
+    }
+    g.start[n] = g.edges.size();
+    return g;
+}
+
+long long DijkstraLazy(const Graph& g, int n) {
+    using Item = std::pair<long long,int>;
+    std::vector<long long> dist(n, std::numeric_limits<long long>::max());
+    PriorityQueue<Item, std::greater<Item>> pq;
+    dist[0] = 0; pq.Push({0, 0});
+    while (pq.Size()) {
+        auto [d, v] = pq.Pop();
+        if (d != dist[v]) continue;                   // устаревшая запись
+        for (size_t e = g.start[v]; e < g.start[v + 1]; ++e) {
+            auto [u, w] = g.edges[e];
+            if (d + w < dist[u]) { dist[u] = d + w; pq.Push({dist[u], u}); }
+        }
+    }
+    long long acc = 0;
+    for (auto d : dist) if (d != std::numeric_limits<long long>::max()) acc += d;
+    return acc;
+}
+
+template<size_t Arity>
+long long DijkstraIndexed(const Graph& g, int n) {
+    using Item = std::pair<long long,int>;
+    using PQ = IndexedPriorityQueue<Item, std::greater<Item>, Arity>;
+    std::vector<long long> dist(n, std::numeric_limits<long long>::max());
+    std::vector<typename PQ::Handle> handle(n);
+    std::vector<char> queued(n, 0);
+    PQ pq;
+    dist[0] = 0; handle[0] = pq.Push({0, 0}); queued[0] = 1;
+    while (pq.Size()) {
+        auto [d, v] = pq.Pop();
+        queued[v] = 0;
+        for (size_t e = g.start[v]; e < g.start[v + 1]; ++e) {
+            auto [u, w] = g.edges[e];
+            if (d + w >= dist[u]) continue;
+            dist[u] = d + w;
+            if (queued[u]) pq.DecreaseKey(handle[u], {dist[u], u});
+            else { handle[u] = pq.Push({dist[u], u}); queued[u] = 1; }
+        }
+    }
+    long long acc = 0;
+    for (auto d : dist) if (d != std::numeric_limits<long long>::max()) acc += d;
+    return acc;
+}
+
+void BenchDijkstra() {
+    for (int n : {100000, 1000000}) {
+        Graph g = RandomGraph(n, 8, 42);
+        size_t m = g.edges.size();
+        long long ref = 0, r = 0;
+        Report("Dijkstra PQ binary+stale", m, MeasureMs([&] { ref = DijkstraLazy(g, n); }));
+        Report("Dijkstra Indexed 2-ary", m, MeasureMs([&] { r = DijkstraIndexed<2>(g, n); }));
+        if (r != ref) std::printf("MISMATCH\n");
+        Report("Dijkstra Indexed 4-ary", m, MeasureMs([&] { r = DijkstraIndexed<4>(g, n); }));
+        if (r != ref) std::printf("MISMATCH\n");
+        Report("Dijkstra Indexed 8-ary", m, MeasureMs([&] { r = DijkstraIndexed<8>(g, n); }));
+        if (r != ref) std::printf("MISMATCH\n");
+    }
+}
+
+// ----------------- 6) PriorityQueue: загрузка снимка и выгрузка top-k -------------------
+
+void BenchHeapLoad() {
+    const size_t n = 10000000, k = 1000;
+    std::vector<int> snapshot(n);
+    std::mt19937 rng(7);
+    for (auto& v : snapshot) v = int(rng());
+    Report("PQ load: Push x n", n, MeasureMs([&] {
+        PriorityQueue<int> pq;
+        for (int v : snapshot) pq.Push(v);
+        g_sink += pq.Size();
+    }));
+    Report("PQ load: range ctor", n, MeasureMs([&] {
+        PriorityQueue<int> pq(snapshot.begin(), snapshot.end());
+        g_sink += pq.Size();
+    }));
+    PriorityQueue<int> pq(snapshot.begin(), snapshot.end());
+    std::vector<int> out(k);
+    Report("PQ PopN top-1000", k, MeasureMs([&] { g_sink += pq.PopN(k, out.begin()); }));
+}
+
+// ----------------- 7) DynamicArray::PushBack: политики роста, пиковый RSS -------------------
+
+struct PersonRec {                                     // по размеру как Person из tests.cpp
+    int series, number;
+    std::string first, middle, last;
+    std::time_t birth;
+};
+
+// сбрасывает пик RSS процесса (Linux: VmHWM); -1, если /proc недоступен
+void ResetPeakRss() { std::ofstream("/proc/self/clear_refs") << "5"; }
+long PeakRssKb() {
+    std::ifstream in("/proc/self/status");
+    std::string key;
+    long kb = -1;
+    while (in >> key) {
+        if (key == "VmHWM:") { in >> kb; break; }
+        in.ignore(256, '\n');
+    }
+    return kb;
+}
+
+template<class Arr, class Make>
+void PushBackCase(const char* name, size_t n, Make make) {
+    ResetPeakRss();
+    long before = PeakRssKb();
+    double ms = MeasureMs([&] {
+        Arr a;
+        for (size_t i = 0; i < n; ++i) a.push_back(make(i));
+        g_sink += a.size();
+    });
+    Report(name, n, ms);
+    std::printf("%-28s peak RSS +%ld KiB\n", "", PeakRssKb() - before);
+}
+
+// единый интерфейс push_back/size для DynamicArray и std::vector
+template<class T, class G>
+struct DynArr : DynamicArray<T, G> {
+    void   push_back(const T& v) { this->PushBack(v); }
+    void   push_back(T&& v)      { this->PushBack(std::move(v)); }
+    size_t size() const          { return this->GetSize(); }
+};
+
+void BenchPushBack() {
+    const size_t n = 10000000, ns = 2000000;
+    auto mkInt = [](size_t i) { return int(i); };
+    auto mkStr = [](size_t i) { return std::to_string(i) + "-some-longer-payload"; };
+    auto mkRec = [](size_t i) { return PersonRec{10, int(i), "Ivan", "Petrovich", "Ivanov", 0}; };
+
+    PushBackCase<DynArr<int, GrowDouble>>("DynamicArray<int> x2", n, mkInt);
+    PushBackCase<DynArr<int, GrowOneAndHalf>>("DynamicArray<int> x1.5", n, mkInt);
+    PushBackCase<std::vector<int>>("std::vector<int>", n, mkInt);
+    PushBackCase<DynArr<std::string, GrowDouble>>("DynamicArray<string> x2", ns, mkStr);
+    PushBackCase<DynArr<std::string, GrowOneAndHalf>>("DynamicArray<string> x1.5", ns, mkStr);
+    PushBackCase<std::vector<std::string>>("std::vector<string>", ns, mkStr);
+    PushBackCase<DynArr<PersonRec, GrowDouble>>("DynamicArray<Person> x2", ns, mkRec);
+    PushBackCase<DynArr<PersonRec, GrowOneAndHalf>>("DynamicArray<Person> x1.5", ns, mkRec);
+    PushBackCase<std::vector<PersonRec>>("std::vector<Person>", ns, mkRec);
+}
+
+// ----------------- 8) Split / FlatMap на коротких кусках -------------------
+
+void BenchSmallSequences() {
+    const size_t n = 2000000;
+    MutableArraySequence<int> src;
+    std::mt19937 rng(3);
+    for (size_t i = 0; i < n; ++i) src.Append(rng() % 5 == 0 ? 0 : int(i));   // куски ~4 элемента
+    auto isDelim = [](int v) { return v == 0; };
+
+    // как устроен обычный Split: по MutableArraySequence в куче на каждый кусок
+    ReportWithAllocs("Split heap tokens", n, [&] {
+        std::vector<SeqUPtr<int>> parts;
+        auto cur = SeqUPtr<int>(new MutableArraySequence<int>);
+        for (size_t i = 0; i < src.GetLength(); ++i) {
+            if (isDelim(src.Get(i))) {
+                if (cur->GetLength()) parts.push_back(std::move(cur));
+                cur = SeqUPtr<int>(new MutableArraySequence<int>);
+            } else cur->Append(src.Get(i));
+        }
+        g_sink += parts.size();
+    });
+    ReportWithAllocs("Split<8> inline tokens", n, [&] {
+        g_sink += Split<8>(src, isDelim)->GetLength();
+    });
+
+    ReportWithAllocs("FlatMap array subs", n, [&] {
+        g_sink += src.FlatMap<int>([](int v) {
+            auto sub = SeqUPtr<int>(new MutableArraySequence<int>());
+            sub->Append(v); sub->Append(v + 1);
+            return sub;
+        })->GetLength();
+    });
+    ReportWithAllocs("FlatMap small subs", n, [&] {
+        g_sink += src.FlatMap<int>([](int v) {
+            auto sub = SeqUPtr<int>(new SmallArraySequence<int, 2>());
+            sub->Append(v); sub->Append(v + 1);
+            return sub;
+        })->GetLength();
+    });
+}
+
+// ----------------- 9) LinkedList: new на узел против пула -------------------
+
+template<class List>
+void ListLifecycle(const char* name, size_t n) {
+    char label[64];
+    auto* l = new List;
+    std::snprintf(label, sizeof label, "%s build", name);
+    ReportWithAllocs(label, n, [&] { for (size_t i = 0; i < n; ++i) l->Append(int(i)); });
+    std::snprintf(label, sizeof label, "%s traverse", name);
+    Report(label, n, MeasureMs([&] {
+        long long acc = 0;
+        for (int v : *static_cast<const List*>(l)) acc += v;
+        g_sink += acc;
+    }));
+    std::snprintf(label, sizeof label, "%s destroy", name);
+    Report(label, n, MeasureMs([&] { delete l; }));
+}
+
+void BenchNodePool() {
+    const size_t n = 10000000;
+    ListLifecycle<LinkedList<int>>("List heap", n);
+    ListLifecycle<LinkedList<int, NodePool>>("List pool", n);
+}
+
+// ----------------- 10) Бэкенды MutableListSequence: обход, Get(i), вставка в случайное место -------------------
+
+template<class Seq>
+void ListBackendCase(const char* name) {
+    char label[64];
+    const size_t n = 2000000, gets = 200, inserts = 20000;
+    Seq seq;
+    for (size_t i = 0; i < n; ++i) seq.Append(int(i));
+    std::snprintf(label, sizeof label, "%s scan", name);
+    Report(label, n, MeasureMs([&] {
+        long long acc = 0;
+        for (int v : static_cast<const Seq&>(seq)) acc += v;
+        g_sink += acc;
+    }));
+    std::mt19937 rng(11);
+    std::snprintf(label, sizeof label, "%s Get(rand)", name);
+    Report(label, gets, MeasureMs([&] {
+        long long acc = 0;
+        for (size_t i = 0; i < gets; ++i) acc += seq.Get(rng() % n);
+        g_sink += acc;
+    }));
+    Seq small;
+    for (size_t i = 0; i < 1000; ++i) small.Append(int(i));
+    std::snprintf(label, sizeof label, "%s InsertAt(rand)", name);
+    Report(label, inserts, MeasureMs([&] {
+        for (size_t i = 0; i < inserts; ++i) small.InsertAt(int(i), rng() % (small.GetLength() + 1));
+    }));
+}
+
+void BenchListBackends() {
+    ListBackendCase<MutableListSequence<int>>("ListSeq heap");
+    ListBackendCase<MutableListSequence<int, LinkedList<int, NodePool>>>("ListSeq pool");
+    ListBackendCase<MutableListSequence<int, UnrolledLinkedList<int>>>("ListSeq unrolled");
+}
+
+// ----------------- 11) Reduce / Where через ForEachChunk на разных хранилищах -------------------
+
+template<class Seq>
+void ChunkedAlgoCase(const char* name, size_t n) {
+    char label[64];
+    Seq seq;
+    for (size_t i = 0; i < n; ++i) seq.Append(int(i));
+    const Sequence<int>& s = seq;
+    std::snprintf(label, sizeof label, "%s Reduce", name);
+    Report(label, n, MeasureMs([&] { g_sink += s.Reduce(0LL, [](long long a, int v) { return a + v; }); }));
+    std::snprintf(label, sizeof label, "%s Where", name);
+    Report(label, n, MeasureMs([&] { g_sink += s.Where([](int v) { return v & 1; })->GetLength(); }));
+}
+
+void BenchChunkedAlgorithms() {
+    const size_t n = 1000000;
+    ChunkedAlgoCase<MutableArraySequence<int>>("ArraySeq", n);
+    ChunkedAlgoCase<CircularArraySequence<int>>("CircularSeq", n);
+    ChunkedAlgoCase<MutableListSequence<int>>("ListSeq", n);
+    ChunkedAlgoCase<MutableListSequence<int, UnrolledLinkedList<int>>>("ListSeq unrolled", n);
+}
+
+// ----------------- 12) SIMD-ядра: скаляр / SSE2 / AVX2 / AVX-512 -------------------
+
+template<class T>
+void SimdCase(const char* type, size_t n) {
+    std::vector<T> v(n), out(n);
+    std::mt19937 rng(7);
+    for (auto& x : v) x = static_cast<T>(rng() % 1000);
+    auto pred = [](auto x) { return x > T(500); };
+    auto none = [](auto x) { return x < T(0); };      // FindFirst проходит весь массив
+    auto lin  = [](auto x) { return x * T(3) + T(1); };
+    char label[64];
+    for (auto isa : {simd::Isa::Scalar, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512}) {
+        if (static_cast<int>(isa) > static_cast<int>(simd::DetectIsa())) break;
+        simd::ForceIsa(isa);
+        auto run = [&](const char* op, auto f) {
+            std::snprintf(label, sizeof label, "%s %s %s", type, op, simd::IsaName(isa));
+            Report(label, n, MeasureMs(f));
+        };
+        run("Sum",       [&] { g_sink += static_cast<long long>(simd::Sum(v.data(), n)); });
+        run("Min",       [&] { g_sink += static_cast<long long>(simd::Min(v.data(), n)); });
+        run("CountIf",   [&] { g_sink += simd::CountIf(v.data(), n, pred); });
+        run("Transform", [&] { simd::Transform(v.data(), n, out.data(), lin); g_sink += static_cast<long long>(out[n / 2]); });
+        run("Compact",   [&] { g_sink += simd::Compact(v.data(), n, out.data(), pred); });
+        run("FindFirst", [&] { g_sink += simd::FindFirst(v.data(), n, none); });
+    }
+    simd::ForceIsa(simd::DetectIsa());
+}
+
+void BenchSimd() {
+    const size_t n = size_t(1) << 25;
+    SimdCase<int>("int", n);
+    SimdCase<double>("double", n);
+}
+
+// ----------------- 13) Параллельные алгоритмы: масштабирование от 1 потока до всех ядер -------------------
+
+void BenchParallelScaling() {
+    const size_t n = 20000000;
+    MutableArraySequence<double> seq;
+    for (size_t i = 0; i < n; ++i) seq.Append(double(i % 1000));
+    const size_t hw = std::max(1u, std::thread::hardware_concurrency());
+    auto heavy = [](double v) { return std::sqrt(v) * 1.5 + std::sin(v); };   // вычисления, а не память
+    char label[64];
+    std::printf("hardware_concurrency=%zu\n", hw);
+    for (size_t t = 1; t <= hw; t *= 2) {
+        ThreadPool pool(t);
+        std::snprintf(label, sizeof label, "ParallelMap x%zu", t);
+        Report(label, n, MeasureMs([&] { g_sink += (long long)ParallelMap<double>(seq, heavy, pool)->Get(n / 2); }));
+        std::snprintf(label, sizeof label, "ParallelReduce x%zu", t);
+        Report(label, n, MeasureMs([&] {
+            g_sink += (long long)ParallelReduce(seq, 0.0, [&](double a, double v) { return a + heavy(v); },
+                                                [](double a, double b) { return a + b; }, pool);
+        }));
+        std::snprintf(label, sizeof label, "ParallelWhere x%zu", t);
+        Report(label, n, MeasureMs([&] { g_sink += ParallelWhere(seq, [&](double v) { return heavy(v) > 20; }, pool)->GetLength(); }));
+        if (t < hw && t * 2 > hw) t = hw / 2;                // последний шаг — ровно hw
+    }
+}
+
+// ----------------- 14) Многостадийный запрос: Where->Map->Reduce, eager против View() -------------------
+
+template<class F>
+void PipelineCase(const char* name, size_t n, F f) {
+    ResetPeakRss();
+    long before = PeakRssKb();
+    ReportWithAllocs(name, n, f);
+    std::printf("%-28s peak RSS +%ld KiB\n", "", PeakRssKb() - before);
+}
+
+void BenchPipelines() {
+    const size_t n = 50000000;
+    MutableArraySequence<int> seq;
+    for (size_t i = 0; i < n; ++i) seq.Append(int(i % 100000));
+    auto pred = [](int v) { return v % 3 != 0; };
+    auto f    = [](int v) { return (long long)v * v; };
+    auto add  = [](long long a, long long v) { return a + v; };
+    PipelineCase("eager Where->Map->Reduce", n, [&] {
+        g_sink += seq.Where(pred)->Map<long long>(f)->Reduce(0LL, add);
+    });
+    PipelineCase("View Where.Map.Reduce", n, [&] {
+        g_sink += seq.View().Where(pred).Map(f).Reduce(0LL, add);
+    });
+    PipelineCase("eager Where->Map->first 10", n, [&] {
+        g_sink += seq.Where(pred)->Map<long long>(f)->GetSubsequence(0, 9)->GetLength();
+    });
+    PipelineCase("View Where.Map.Take(10)", n, [&] {
+        g_sink += seq.View().Where(pred).Map(f).Take(10).ToSequence()->GetLength();
+    });
+}
+
+// ----------------- 15) Иммутабельные версии: копия массива против PersistentVector -------------------
+
+template<class Seq>
+void AppendHistoryCase(const char* name, size_t n) {
+    ResetPeakRss();
+    long before = PeakRssKb();
+    ReportWithAllocs(name, n, [&] {
+        SeqUPtr<int> cur(new Seq());
+        std::vector<SeqUPtr<int>> hist;                      // каждая 1000-я версия остаётся живой
+        for (size_t i = 0; i < n; ++i) {
+            cur = static_cast<const Sequence<int>&>(*cur).Append(int(i));
+            if (i % 1000 == 0) hist.push_back(cur->Clone());
+        }
+        g_sink += cur->GetLast() + hist.size();
+    });
+    std::printf("%-28s peak RSS +%ld KiB\n", "", PeakRssKb() - before);
+}
+
+void BenchPersistent() {
+    AppendHistoryCase<ImmutableArraySequence<int>>("ImmutableArray Append", 20000);
+    AppendHistoryCase<PersistentArraySequence<int>>("Persistent Append", 20000);
+    AppendHistoryCase<PersistentArraySequence<int>>("Persistent Append", 1000000);
+
+    const size_t n = 1000000, q = 200000;
+    std::vector<int> src(n);
+    for (size_t i = 0; i < n; ++i) src[i] = int(i);
+    PersistentVector<int> v(src.data(), n);
+    std::mt19937 rng(3);
+    std::vector<PersistentVector<int>> hist;
+    hist.reserve(q);
+    ReportWithAllocs("Persistent Set + history", q, [&] {
+        PersistentVector<int> cur = v;
+        for (size_t i = 0; i < q; ++i) { cur = cur.Set(rng() % n, int(i)); hist.push_back(cur); }
+    });
+    Report("Persistent Get random", q, MeasureMs([&] {
+        long long acc = 0;
+        for (size_t i = 0; i < q; ++i) acc += hist[i][rng() % n];
+        g_sink += acc;
+    }));
+    Report("Persistent Reduce 1M", n, MeasureMs([&] {
+        g_sink += PersistentArraySequence<int>(v).Reduce(0LL, [](long long a, int x) { return a + x; });
+    }));
+}
+
+// ----------------- 16) ImmutableListSequence: копия LinkedList против PersistentList -------------------
+
+template<class Seq>
+void PrependHistoryCase(const char* name, size_t n) {
+    ResetPeakRss();
+    long before = PeakRssKb();
+    ReportWithAllocs(name, n, [&] {
+        std::vector<SeqUPtr<int>> hist;                      // все версии живы
+        hist.emplace_back(new Seq());
+        for (size_t i = 0; i < n; ++i) hist.push_back(static_cast<const Sequence<int>&>(*hist.back()).Prepend(int(i)));
+        g_sink += hist.back()->GetFirst() + hist.size();
+    });
+    std::printf("%-28s peak RSS +%ld KiB\n", "", PeakRssKb() - before);
+}
+
+void BenchPersistentList() {
+    PrependHistoryCase<ImmutableListSequence<int, LinkedList<int>>>("ImmList(LinkedList) Prepend", 3000);
+    PrependHistoryCase<ImmutableListSequence<int>>("ImmList(Persistent) Prepend", 3000);
+    PrependHistoryCase<ImmutableListSequence<int>>("ImmList(Persistent) Prepend", 1000000);
+    const size_t n = 1000000;
+    ImmutableListSequence<int> big;
+    SeqUPtr<int> cur = big.Clone();
+    for (size_t i = 0; i < n; ++i) cur = static_cast<const Sequence<int>&>(*cur).Prepend(int(i));
+    Report("ImmList suffix subseq", 1000, MeasureMs([&] {
+        for (size_t i = 0; i < 1000; ++i) g_sink += cur->GetSubsequence(i, n - 1)->GetLength();
+    }));
+    ReportWithAllocs("ImmList Append chain", n, [&] {
+        SeqUPtr<int> s = big.Clone();
+        for (size_t i = 0; i < n; ++i) s = static_cast<const Sequence<int>&>(*s).Append(int(i));
+        g_sink += s->GetLength();
+    });
+}
+
+// ----------------- 17) GetSubsequence: копия окна против среза -------------------
+
+void BenchSlices() {
+    const size_t n = 50000000, win = 10000000;
+    MutableArraySequence<int> seq;
+    for (size_t i = 0; i < n; ++i) seq.Append(int(i));
+    PipelineCase("window copy 10M", win, [&] {
+        MutableArraySequence<int> cp(&seq.Get(n / 2), win);
+        g_sink += cp.GetLast();
+    });
+    PipelineCase("GetSubsequence 10M (view)", win, [&] {
+        auto v = seq.GetSubsequence(n / 2, n / 2 + win - 1);
+        g_sink += v->GetLast() + v->Reduce(0LL, [](long long a, int x) { return a + x; });
+    });
+    Report("100 windows (view)", 100, MeasureMs([&] {
+        for (size_t k = 0; k < 100; ++k) g_sink += SliceView<int>(seq, k * 100000, win)->GetLength();
+    }));
+    MutableArraySequence<int> csv;
+    for (size_t i = 0; i < 10000000; ++i) csv.Append(i % 16 == 15 ? -1 : int(i));
+    ReportWithAllocs("Split<16> copies", csv.GetLength(), [&] {
+        g_sink += Split<16>(csv, [](int v) { return v < 0; })->GetLength();
+    });
+    ReportWithAllocs("SplitView", csv.GetLength(), [&] {
+        g_sink += SplitView(csv, [](int v) { return v < 0; })->GetLength();
+    });
+}
+
+// ----------------- 18) Rope против массива: вставки в середину, Concat, Slice -------------------
+void BenchRope() {
+    const size_t n = 1000000, ins = 20000;
+    std::vector<int> base(n);
+    for (size_t i = 0; i < n; ++i) base[i] = int(i);
+    {
+        MutableArraySequence<int> arr(base.data(), n);
+        Report("Array InsertAt middle", ins / 20, MeasureMs([&] {      // O(n) на вставку — меньше повторов
+            for (size_t i = 0; i < ins / 20; ++i) arr.InsertAt(int(i), arr.GetLength() / 2);
+        }));
+        RopeSequence<int> rope(base.data(), n);
+        Report("Rope InsertAt middle", ins, MeasureMs([&] {
+            for (size_t i = 0; i < ins; ++i) rope.InsertAt(int(i), rope.GetLength() / 2);
+        }));
+        Report("Array Get random", n, MeasureMs([&] {
+            size_t x = 1;
+            for (size_t i = 0; i < n; ++i) { x = x * 6364136223846793005ULL + 1; g_sink += arr.Get(x % n); }
+        }));
+        Report("Rope Get random", n, MeasureMs([&] {
+            size_t x = 1;
+            for (size_t i = 0; i < n; ++i) { x = x * 6364136223846793005ULL + 1; g_sink += rope.Get(x % n); }
+        }));
+        long long a = 0, b = 0;
+        Report("Array ForEach", n, MeasureMs([&] { arr.ForEach([&](int v) { a += v; }); }));
+        Report("Rope ForEach (chunks)", n, MeasureMs([&] { rope.ForEach([&](int v) { b += v; }); }));
+        g_sink += a + b;
+    }
+    MutableArraySequence<int> arr(base.data(), n);
+    RopeSequence<int> rope(base.data(), n);
+    ReportWithAllocs("Array Concat x20 (1M)", 20, [&] {
+        MutableArraySequence<int> acc;
+        for (int k = 0; k < 20; ++k) acc.Concat(&arr);
+        g_sink += acc.GetLength();
+    });
+    ReportWithAllocs("Rope Concat x20 (1M)", 20, [&] {
+        RopeSequence<int> acc;
+        for (int k = 0; k < 20; ++k) acc.Concat(&rope);
+        g_sink += acc.GetLength();
+    });
+    int patch[] = {-1, -2, -3};
+    MutableArraySequence<int> parr(patch, 3);
+    RopeSequence<int> prope(patch, 3);
+    ReportWithAllocs("Array Slice+repl x100", 100, [&] {
+        for (int k = 0; k < 100; ++k) g_sink += Slice<int>(arr, k * 1000, 500000, &parr)->GetLength();
+    });
+    ReportWithAllocs("Rope Slice+repl x100", 100, [&] {
+        for (int k = 0; k < 100; ++k) g_sink += Slice<int>(rope, k * 1000, 500000, &prope)->GetLength();
+    });
+}
+
+// ----------------- 19) Копии и переносы на операцию: const T& против T&& и Emplace -------------------
+
+struct CountedRec {                                    // PersonRec, считающий свои копии и переносы
+    static size_t copies, moves;
+    int series = 0, number = 0;
+    std::string first, middle, last;
+    CountedRec() = default;
+    CountedRec(int s, int n, const char* f, const char* m, const char* l)
+        : series(s), number(n), first(f), middle(m), last(l) {}
+    CountedRec(const CountedRec& o)
+        : series(o.series), number(o.number), first(o.first), middle(o.middle), last(o.last) { ++copies; }
+    CountedRec(CountedRec&& o) noexcept
+        : series(o.series), number(o.number), first(std::move(o.first)), middle(std::move(o.middle)), last(std::move(o.last)) { ++moves; }
+    CountedRec& operator=(const CountedRec& o) {
+        series = o.series; number = o.number;
+        first = o.first; middle = o.middle; last = o.last;
+        ++copies; return *this;
+    }
+    CountedRec& operator=(CountedRec&& o) noexcept {
+        series = o.series; number = o.number;
+        first = std::move(o.first); middle = std::move(o.middle); last = std::move(o.last);
+        ++moves; return *this;
+    }
+    bool operator<(const CountedRec& o) const { return number < o.number; }
+};
+size_t CountedRec::copies = 0, CountedRec::moves = 0;
+
+template<class F>
+void CopyMoveCase(const char* name, size_t n, F f) {
+    CountedRec::copies = CountedRec::moves = 0;
+    Report(name, n, MeasureMs(f));
+    std::printf("%-28s %.2f copies/op  %.2f moves/op\n", "",
+                double(CountedRec::copies) / n, double(CountedRec::moves) / n);
+}
+
+// const T&, T&& и Emplace на одном контейнере: add(c, v) — вставка, emplace(c, args...)
+template<class C, class Add, class Emplace>
+void InsertPaths(const char* lv, const char* rv, const char* em, size_t n, Add add, Emplace emplace) {
+    CopyMoveCase(lv, n, [&] {
+        C c;
+        for (size_t i = 0; i < n; ++i) { CountedRec r(10, int(i), "Ivan", "Petrovich", "Ivanov"); add(c, r); }
+    });
+    CopyMoveCase(rv, n, [&] {
+        C c;
+        for (size_t i = 0; i < n; ++i) add(c, CountedRec(10, int(i), "Ivan", "Petrovich", "Ivanov"));
+    });
+    CopyMoveCase(em, n, [&] {
+        C c;
+        for (size_t i = 0; i < n; ++i) emplace(c, 10, int(i), "Ivan", "Petrovich", "Ivanov");
+    });
+}
+
+void BenchCopyMove() {
+    const size_t n = 1000000;
+    InsertPaths<MutableArraySequence<CountedRec>>("ArraySeq Append(const&)", "ArraySeq Append(&&)", "ArraySeq EmplaceBack", n,
+        [](auto& c, auto&& v) { c.Append(std::forward<decltype(v)>(v)); },
+        [](auto& c, auto&&... a) { c.EmplaceBack(std::forward<decltype(a)>(a)...); });
+    InsertPaths<MutableListSequence<CountedRec>>("ListSeq Append(const&)", "ListSeq Append(&&)", "ListSeq EmplaceBack", n,
+        [](auto& c, auto&& v) { c.Append(std::forward<decltype(v)>(v)); },
+        [](auto& c, auto&&... a) { c.EmplaceBack(std::forward<decltype(a)>(a)...); });
+    InsertPaths<Deque<CountedRec>>("Deque PushBack(const&)", "Deque PushBack(&&)", "Deque EmplaceBack", n,
+        [](auto& c, auto&& v) { c.PushBack(std::forward<decltype(v)>(v)); },
+        [](auto& c, auto&&... a) { c.EmplaceBack(std::forward<decltype(a)>(a)...); });
+    InsertPaths<Stack<CountedRec>>("Stack Push(const&)", "Stack Push(&&)", "Stack Emplace", n,
+        [](auto& c, auto&& v) { c.Push(std::forward<decltype(v)>(v)); },
+        [](auto& c, auto&&... a) { c.Emplace(std::forward<decltype(a)>(a)...); });
+    InsertPaths<PriorityQueue<CountedRec>>("PQ Push(const&)", "PQ Push(&&)", "PQ Emplace", n,
+        [](auto& c, auto&& v) { c.Push(std::forward<decltype(v)>(v)); },
+        [](auto& c, auto&&... a) { c.Emplace(std::forward<decltype(a)>(a)...); });
+
+    MutableArraySequence<CountedRec> seq;
+    for (size_t i = 0; i < 1000; ++i) seq.EmplaceBack(10, int(i), "Ivan", "Petrovich", "Ivanov");
+    CopyMoveCase("GetFirst by value", n, [&] {
+        for (size_t i = 0; i < n; ++i) { CountedRec r = seq.GetFirst(); g_sink += r.number; }
+    });
+    CopyMoveCase("GetFirst by ref", n, [&] {
+        for (size_t i = 0; i < n; ++i) { const CountedRec& r = seq.GetFirst(); g_sink += r.number; }
+    });
+    CopyMoveCase("InsertAt(&&) middle x1000", 1000, [&] {
+        for (size_t i = 0; i < 1000; ++i) seq.InsertAt(CountedRec(1, 2, "a", "b", "c"), seq.GetLength() / 2);
+    });
+}
+
+// ----------------- 20) Вставка диапазонов: по элементу против InsertRange / пачечного Concat -------------------
+void BenchRanges() {
+    const size_t n = 1000000, k = 1000, reps = 200;
+    std::vector<int> base(n), piece(k);
+    for (size_t i = 0; i < n; ++i) base[i] = int(i);
+    for (size_t i = 0; i < k; ++i) piece[i] = -int(i);
+    {
+        MutableArraySequence<int> seq(base.data(), n);
+        ReportWithAllocs("InsertAt x1000 middle", reps / 20, [&] {   // O(k*n) — меньше повторов
+            for (size_t r = 0; r < reps / 20; ++r)
+                for (size_t i = 0; i < k; ++i) seq.InsertAt(piece[i], n / 2 + i);
+        });
+    }
+    {
+        MutableArraySequence<int> seq(base.data(), n);
+        ReportWithAllocs("InsertRange 1000 middle", reps, [&] {
+            for (size_t r = 0; r < reps; ++r) seq.InsertRange(n / 2, piece.begin(), piece.end());
+        });
+    }
+    std::vector<std::string> words(k, std::string(40, 'w'));
+    {
+        DynamicArray<std::string> ds;
+        for (size_t i = 0; i < 100000; ++i) ds.PushBack("x");
+        ReportWithAllocs("string InsertRange 1000", 50, [&] {
+            for (size_t r = 0; r < 50; ++r) ds.InsertRange(1000, words.begin(), words.end());
+        });
+    }
+    MutableArraySequence<int> arr(base.data(), n);
+    MutableListSequence<int, UnrolledLinkedList<int, 256>> ul(base.data(), n);
+    ReportWithAllocs("Concat array 1M (by elem)", n, [&] {
+        MutableArraySequence<int> acc;
+        arr.ForEach([&](int v) { acc.Append(v); });
+        g_sink += acc.GetLength();
+    });
+    ReportWithAllocs("Concat array 1M (ranges)", n, [&] {
+        MutableArraySequence<int> acc;
+        acc.Concat(&arr);
+        g_sink += acc.GetLength();
+    });
+    ReportWithAllocs("Concat unrolled 1M (ranges)", n, [&] {
+        MutableArraySequence<int> acc;
+        acc.Concat(&ul);
+        g_sink += acc.GetLength();
+    });
+    MutableArraySequence<int> repl(piece.data(), k);
+    ReportWithAllocs("Slice 1M + repl 1000", n, [&] {
+        g_sink += Slice<int>(arr, int(n / 3), n / 3, &repl)->GetLength();
+    });
+}
+
+// ----------------- 21) Проверка границ: сумма 100M int по [] / GetUnchecked / data() / Reduce -------------------
+template<class A>
+long long SumIndexed(const A& a, size_t n) {
+    long long s = 0;
+    for (size_t i = 0; i < n; ++i) s += a[i];
+    return s;
+}
+
+void BenchBounds() {
+    const size_t n = 100000000;
+    DynamicArray<int> chk;
+    chk.Resize(n);
+    for (size_t i = 0; i < n; ++i) chk[i] = int(i & 1023);
+    DynamicArray<int, GrowDouble, UncheckedBounds> unc;
+    unc.AppendRange(chk.begin(), chk.end());
+    Report("[] checked 100M", n, MeasureMs([&] { g_sink += SumIndexed(chk, n); }));
+    Report("[] unchecked 100M", n, MeasureMs([&] { g_sink += SumIndexed(unc, n); }));
+    Report("GetUnchecked 100M", n, MeasureMs([&] {
+        long long s = 0;
+        for (size_t i = 0; i < n; ++i) s += chk.GetUnchecked(i);
+        g_sink += s;
+    }));
+    Report("data() pointer 100M", n, MeasureMs([&] {
+        long long s = 0;
+        const int* p = chk.data();
+        for (size_t i = 0; i < n; ++i) s += p[i];
+        g_sink += s;
+    }));
+    chk = DynamicArray<int>(); unc = decltype(unc)();
+    std::vector<int> src(n);
+    for (size_t i = 0; i < n; ++i) src[i] = int(i & 1023);
+    MutableArraySequence<int> seq(src.data(), n);
+    MutableArraySequence<int, UncheckedBounds> useq(src.data(), n);
+    src = std::vector<int>();
+    auto add = [](long long acc, int v) { return acc + v; };
+    Report("Seq Get checked 100M", n, MeasureMs([&] {   // виртуальный вызов на элемент
+        long long s = 0;
+        for (size_t i = 0; i < n; ++i) s += seq.Get(i);
+        g_sink += s;
+    }));
+    Report("Seq Get unchecked 100M", n, MeasureMs([&] {
+        long long s = 0;
+        for (size_t i = 0; i < n; ++i) s += useq.Get(i);
+        g_sink += s;
+    }));
+    Report("Seq Reduce 100M", n, MeasureMs([&] { g_sink += seq.Reduce(0LL, add); }));
+}
+
+// ----------------- 22) Сортировки: 100M int и 10M записей с ключом PersonID -------------------
+void BenchSort() {
+    const size_t n = 100000000, k = 1000;
+    std::mt19937 rng(22);
+    auto fill = [&](int* p, size_t m) { rng.seed(22); for (size_t i = 0; i < m; ++i) p[i] = int(rng()); };
+    {
+        std::vector<int> v(n);
+        fill(v.data(), n);
+        Report("std::sort vector 100M", n, MeasureMs([&] { std::sort(v.begin(), v.end()); }));
+        g_sink += v[n / 2];
+    }
+    MutableArraySequence<int> seq;
+    {
+        DynamicArray<int> d(n);
+        fill(d.begin(), n);
+        seq = MutableArraySequence<int>(std::move(d));
+    }
+    Report("Sort 100M", n, MeasureMs([&] { Sort(seq); }));
+    Report("Sort 100M (sorted)", n, MeasureMs([&] { Sort(seq); }));
+    fill(seq.begin(), n);
+    Report("StableSort 100M", n, MeasureMs([&] { StableSort(seq); }));
+    fill(seq.begin(), n);
+    Report("ParallelSort 100M", n, MeasureMs([&] { ParallelSort(seq); }));
+    std::printf("%-28s %zu threads\n", "", ThreadPool::Default().Size());
+    fill(seq.begin(), n);
+    Report("PartialSort 100M k=1000", n, MeasureMs([&] { PartialSort(seq, k); }));
+    fill(seq.begin(), n);
+    Report("NthElement 100M median", n, MeasureMs([&] { NthElement(seq, n / 2); }));
+    g_sink += seq.Get(n / 2);
+    seq = MutableArraySequence<int>();
+
+    const size_t m = 10000000;
+    auto byId = [](const PersonRec& a, const PersonRec& b) {
+        return a.series != b.series ? a.series < b.series : a.number < b.number;
+    };
+    DynamicArray<PersonRec> people;
+    people.Reserve(m);
+    auto refill = [&] {
+        rng.seed(7);
+        people.Resize(0);
+        for (size_t i = 0; i < m; ++i)
+            people.PushBack(PersonRec{ int(rng() % 100), int(rng() % 1000000), "Ivan", "Petrovich", "Ivanov", std::time_t(i) });
+    };
+    {
+        refill();
+        std::vector<PersonRec> v(people.begin(), people.end());
+        Report("std::sort Person 10M", m, MeasureMs([&] { std::sort(v.begin(), v.end(), byId); }));
+    }
+    refill();
+    Report("Sort Person 10M", m, MeasureMs([&] { Sort(people, byId); }));
+    refill();
+    Report("StableSort Person 10M", m, MeasureMs([&] { StableSort(people, byId); }));
+    refill();
+    Report("ParallelSort Person 10M", m, MeasureMs([&] { ParallelSort(people, byId); }));
+    g_sink += people[m / 2].number;
+
+    // список: раньше — копия в vector, sort, запись обратно; теперь — перецепка узлов
+    const size_t l = 5000000;
+    std::vector<int> src(l);
+    fill(src.data(), l);
+    {
+        MutableListSequence<int> ls(src.data(), l);
+        Report("List via vector 5M", l, MeasureMs([&] {
+            std::vector<int> tmp;
+            tmp.reserve(l);
+            ls.ForEach([&](int v) { tmp.push_back(v); });
+            std::sort(tmp.begin(), tmp.end());
+            auto it = tmp.begin();
+            for (int& v : ls) v = *it++;
+        }));
+    }
+    {
+        MutableListSequence<int> ls(src.data(), l);
+        Report("List Sort (relink) 5M", l, MeasureMs([&] { Sort(ls); }));
+        g_sink += ls.GetFirst();
+    }
+    {
+        MutableListSequence<int, UnrolledLinkedList<int>> us(src.data(), l);
+        Report("Unrolled Sort 5M", l, MeasureMs([&] { Sort(us); }));
+        g_sink += us.GetFirst();
+    }
+}
+
+// ----------------- 23) Поразрядная сортировка против сравнений: 10M..100M ключей -------------------
+// 1B 32-битных ключей — 4 ГБ данных и столько же буфера LSD; размер задаётся тут
+void BenchRadix() {
+    for (size_t n : {size_t(10000000), size_t(100000000)}) {
+        DynamicArray<int> a(n);
+        std::mt19937 rng(23);
+        auto refill = [&] { rng.seed(23); for (int& v : a) v = int(rng()); };
+        refill();
+        std::printf("-- %zu int\n", n);
+        Report("Sort (pdq)", n, MeasureMs([&] { Sort(a); }));
+        for (unsigned bits : {8u, 11u, 16u}) {
+            refill();
+            RadixOptions opt;
+            opt.DigitBits = bits;
+            char name[32];
+            std::snprintf(name, sizeof name, "RadixSort LSD %u-bit", bits);
+            Report(name, n, MeasureMs([&] { RadixSort(a, radix::Identity(), opt); }));
+        }
+        refill();
+        Report("RadixSort LSD par-hist", n, MeasureMs([&] {
+            RadixOptions opt;
+            opt.Pool = &ThreadPool::Default();
+            RadixSort(a, radix::Identity(), opt);
+        }));
+        refill();
+        Report("RadixSortMsd 8-bit", n, MeasureMs([&] { RadixSortMsd(a); }));
+        for (int& v : a) v &= 0xFFFF;                            // старшие разряды постоянны
+        Report("RadixSort LSD 16-bit keys", n, MeasureMs([&] { RadixSort(a); }));
+        g_sink += a[n / 2];
+    }
+
+    const size_t n = 10000000;
+    std::mt19937 rng(23);
+    DynamicArray<double> d(n);
+    auto refillD = [&] { rng.seed(5); for (double& v : d) v = std::ldexp(double(rng()) - 2147483648.0, int(rng() % 64) - 32); };
+    refillD();
+    std::printf("-- %zu double\n", n);
+    Report("Sort (pdq) double", n, MeasureMs([&] { Sort(d); }));
+    refillD();
+    Report("RadixSort LSD double", n, MeasureMs([&] { RadixSort(d); }));
+    g_sink += int(d[n / 2]);
+
+    // записи с составным ключом {series, number}
+    DynamicArray<PersonRec> people;
+    people.Reserve(n);
+    auto refillP = [&] {
+        rng.seed(7);
+        people.Resize(0);
+        for (size_t i = 0; i < n; ++i)
+            people.PushBack(PersonRec{ int(rng() % 100), int(rng() % 1000000), "Ivan", "Petrovich", "Ivanov", std::time_t(i) });
+    };
+    auto idKey = [](const PersonRec& p) { return std::make_pair(p.series, p.number); };
+    refillP();
+    std::printf("-- %zu Person by PersonID\n", n);
+    Report("StableSort Person", n, MeasureMs([&] {
+        StableSort(people, [&](const PersonRec& a, const PersonRec& b) { return idKey(a) < idKey(b); });
+    }));
+    refillP();
+    Report("RadixSort LSD Person", n, MeasureMs([&] { RadixSort(people, idKey); }));
+    refillP();
+    Report("RadixSortMsd Person", n, MeasureMs([&] { RadixSortMsd(people, idKey); }));
+    g_sink += people[n / 2].number;
+}
+
+// ----------------- 24) Сводный прогон: размеры 1e2..--max-n, типы int / double / string / Person -------------------
+// Каждый контейнер и алгоритм против ближайшего аналога из std; ns/op — на элемент.
+// Проход f() повторяется, пока не наберётся kSuiteOps операций, — малые n тоже измеримы.
+
+constexpr size_t kSuiteOps  = 1000000;
+constexpr size_t kQuadMax   = 10000;     // O(n) на операцию (иммутабельный Append) — не дальше
+constexpr size_t kLinearMax = 100000;    // Get(i) на списке — не дальше
+static size_t g_maxN = 1000000;          // --max-n
+
+bool operator<(const PersonRec& a, const PersonRec& b) {
+    return a.series != b.series ? a.series < b.series : a.number < b.number;
+}
+
+template<class T> T MakeValue(size_t i);
+template<> int MakeValue<int>(size_t i)                 { return int(i * 2654435761u % 1000003); }
+template<> double MakeValue<double>(size_t i)           { return MakeValue<int>(i) * 0.5; }
+template<> std::string MakeValue<std::string>(size_t i) { return "person-key-" + std::to_string(MakeValue<int>(i)); }
+template<> PersonRec MakeValue<PersonRec>(size_t i) {
+    int k = MakeValue<int>(i);
+    return PersonRec{ k % 100, k, "Ivan", "Petrovich", "Ivanov", std::time_t(i) };
+}
+
+long long KeyOf(int v)                { return v; }
+long long KeyOf(double v)             { return static_cast<long long>(v); }
+long long KeyOf(const std::string& v) { return static_cast<long long>(std::hash<std::string>()(v) >> 1); }
+long long KeyOf(const PersonRec& v)   { return v.number; }
+
+template<class T> const char* TypeName();
+template<> const char* TypeName<int>()         { return "int"; }
+template<> const char* TypeName<double>()      { return "double"; }
+template<> const char* TypeName<std::string>() { return "string"; }
+template<> const char* TypeName<PersonRec>()   { return "Person"; }
+
+// f() — проход на ops операций над контейнером из n элементов, reps раз подряд
+template<class F>
+void SuiteCase(const char* name, size_t n, size_t ops, size_t reps, F f) {
+    Report(name, ops * reps, MeasureMs([&] { for (size_t r = 0; r < reps; ++r) f(); }), n);
+}
+
+template<class T>
+void SuiteContainers(const std::vector<T>& src, size_t reps) {
+    const size_t n = src.size(), q = 1000;
+    std::vector<size_t> idx(q);
+    std::mt19937 rng(24);
+    for (auto& i : idx) i = rng() % n;
+
+    SuiteCase("DynamicArray PushBack", n, n, reps, [&] {
+        DynamicArray<T> a;
+        for (const T& v : src) a.PushBack(v);
+        g_sink += a.GetSize();
+    });
+    SuiteCase("std::vector push_back", n, n, reps, [&] {
+        std::vector<T> a;
+        for (const T& v : src) a.push_back(v);
+        g_sink += a.size();
+    });
+    {
+        DynamicArray<T> a;
+        a.AppendRange(src.begin(), src.end());
+        SuiteCase("DynamicArray []", n, n, reps, [&] {
+            long long acc = 0;
+            for (size_t i = 0; i < n; ++i) acc += KeyOf(a[i]);
+            g_sink += acc;
+        });
+        SuiteCase("std::vector []", n, n, reps, [&] {
+            long long acc = 0;
+            for (size_t i = 0; i < n; ++i) acc += KeyOf(src[i]);
+            g_sink += acc;
+        });
+    }
+    SuiteCase("LinkedList Append+PopFront", n, n, reps, [&] {
+        LinkedList<T> l;
+        for (const T& v : src) l.Append(v);
+        while (l.GetLength()) g_sink += KeyOf(l.PopFront());
+    });
+    SuiteCase("std::list push_back+pop_front", n, n, reps, [&] {
+        std::list<T> l;
+        for (const T& v : src) l.push_back(v);
+        while (!l.empty()) { g_sink += KeyOf(l.front()); l.pop_front(); }
+    });
+    {
+        LinkedList<T> l(src.data(), n);
+        std::list<T> sl(src.begin(), src.end());
+        SuiteCase("LinkedList traverse", n, n, reps, [&] {
+            long long acc = 0;
+            for (const T& v : l) acc += KeyOf(v);
+            g_sink += acc;
+        });
+        SuiteCase("std::list traverse", n, n, reps, [&] {
+            long long acc = 0;
+            for (const T& v : sl) acc += KeyOf(v);
+            g_sink += acc;
+        });
+    }
+
+    // четыре класса последовательностей: обход, Get(i), подпоследовательность;
+    // getReps — повторы Get(i) (на списке O(n) на вызов — один проход), 0 — пропустить
+    auto seqCases = [&](const char* cls, auto make, size_t getReps) {
+        char label[64];
+        auto s = make();
+        const Sequence<T>& seq = *s;
+        std::snprintf(label, sizeof label, "%s ForEach", cls);
+        SuiteCase(label, n, n, reps, [&] {
+            long long acc = 0;
+            seq.ForEach([&](const T& v) { acc += KeyOf(v); });
+            g_sink += acc;
+        });
+        if (getReps) {
+            std::snprintf(label, sizeof label, "%s Get random", cls);
+            SuiteCase(label, n, q, getReps, [&] {
+                long long acc = 0;
+                for (size_t i : idx) acc += KeyOf(seq.Get(i));
+                g_sink += acc;
+            });
+        }
+        std::snprintf(label, sizeof label, "%s GetSubsequence", cls);
+        SuiteCase(label, n, n / 2, reps, [&] { g_sink += seq.GetSubsequence(n / 4, n / 4 + n / 2 - 1)->GetLength(); });
+    };
+    seqCases("MutableArraySeq", [&] { return std::make_unique<MutableArraySequence<T>>(src.data(), n); }, reps);
+    seqCases("ImmutableArraySeq", [&] { return std::make_unique<ImmutableArraySequence<T>>(src.data(), n); }, reps);
+    seqCases("MutableListSeq", [&] { return std::make_unique<MutableListSequence<T>>(src.data(), n); }, n <= kLinearMax ? 1 : 0);
+    seqCases("ImmutableListSeq", [&] { return std::make_unique<ImmutableListSequence<T>>(src.data(), n); }, n <= kLinearMax ? 1 : 0);
+
+    SuiteCase("MutableArraySeq Append", n, n, reps, [&] {
+        MutableArraySequence<T> s;
+        for (const T& v : src) s.Append(v);
+        g_sink += s.GetLength();
+    });
+    SuiteCase("MutableListSeq Append", n, n, reps, [&] {
+        MutableListSequence<T> s;
+        for (const T& v : src) s.Append(v);
+        g_sink += s.GetLength();
+    });
+    if (n <= kQuadMax)
+        SuiteCase("ImmutableArraySeq Append", n, n, 1, [&] {
+            SeqUPtr<T> cur(new ImmutableArraySequence<T>());
+            for (const T& v : src) cur = static_cast<const Sequence<T>&>(*cur).Append(v);
+            g_sink += cur->GetLength();
+        });
+    SuiteCase("ImmutableListSeq Prepend", n, n, reps, [&] {
+        SeqUPtr<T> cur(new ImmutableListSequence<T>());
+        for (const T& v : src) cur = static_cast<const Sequence<T>&>(*cur).Prepend(v);
+        g_sink += cur->GetLength();
+    });
+}
+
+template<class T>
+void SuiteAdapters(const std::vector<T>& src, size_t reps) {
+    const size_t n = src.size();
+    SuiteCase("Stack Push+Pop", n, n, reps, [&] {
+        Stack<T> s;
+        for (const T& v : src) s.Push(v);
+        while (s.Size()) g_sink += KeyOf(s.Pop());
+    });
+    SuiteCase("std::stack push+pop", n, n, reps, [&] {
+        std::stack<T, std::vector<T>> s;
+        for (const T& v : src) s.push(v);
+        while (!s.empty()) { g_sink += KeyOf(s.top()); s.pop(); }
+    });
+    SuiteCase("Queue Enqueue+Dequeue", n, n, reps, [&] {
+        Queue<T> s;
+        for (const T& v : src) s.Enqueue(v);
+        while (s.Size()) g_sink += KeyOf(s.Dequeue());
+    });
+    SuiteCase("std::queue push+pop", n, n, reps, [&] {
+        std::queue<T> s;
+        for (const T& v : src) s.push(v);
+        while (!s.empty()) { g_sink += KeyOf(s.front()); s.pop(); }
+    });
+    SuiteCase("Deque PushFront+PopBack", n, n, reps, [&] {
+        Deque<T> s;
+        for (const T& v : src) s.PushFront(v);
+        while (s.Size()) g_sink += KeyOf(s.PopBack());
+    });
+    SuiteCase("std::deque push_front+pop_back", n, n, reps, [&] {
+        std::deque<T> s;
+        for (const T& v : src) s.push_front(v);
+        while (!s.empty()) { g_sink += KeyOf(s.back()); s.pop_back(); }
+    });
+    SuiteCase("PriorityQueue Push+Pop", n, n, reps, [&] {
+        PriorityQueue<T> s;
+        for (const T& v : src) s.Push(v);
+        while (s.Size()) g_sink += KeyOf(s.Pop());
+    });
+    SuiteCase("std::priority_queue push+pop", n, n, reps, [&] {
+        std::priority_queue<T> s;
+        for (const T& v : src) s.push(v);
+        while (!s.empty()) { g_sink += KeyOf(s.top()); s.pop(); }
+    });
+    SuiteCase("PriorityQueue from range", n, n, reps, [&] {
+        PriorityQueue<T> s(src.begin(), src.end());
+        g_sink += KeyOf(s.Top());
+    });
+    SuiteCase("std::priority_queue from range", n, n, reps, [&] {
+        std::priority_queue<T> s(src.begin(), src.end());
+        g_sink += KeyOf(s.top());
+    });
+}
+
+template<class T>
+void SuiteAlgorithms(const std::vector<T>& src, size_t reps) {
+    const size_t n = src.size();
+    MutableArraySequence<T> seq(src.data(), n);
+    auto keep  = [](const T& v) { return KeyOf(v) % 2 == 0; };
+    auto delim = [](const T& v) { return KeyOf(v) % 16 == 0; };
+    const long long last = KeyOf(src.back());
+    auto isLast = [last](const T& v) { return KeyOf(v) == last; };
+    auto single = [](const T& v) { SeqUPtr<T> s(new MutableArraySequence<T>); s->Append(v); return s; };
+
+    SuiteCase("Zip", n, n, reps, [&] { g_sink += Zip(seq, seq)->GetLength(); });
+    {
+        auto z = Zip(seq, seq);
+        SuiteCase("Unzip", n, n, reps, [&] { g_sink += Unzip(*z).first->GetLength(); });
+    }
+    SuiteCase("Split", n, n, reps, [&] { g_sink += Split(seq, delim)->GetLength(); });
+    SuiteCase("Split<16>", n, n, reps, [&] { g_sink += Split<16>(seq, delim)->GetLength(); });
+    SuiteCase("SplitView", n, n, reps, [&] { g_sink += SplitView(seq, delim)->GetLength(); });
+    SuiteCase("SliceView", n, 1, kSuiteOps / 100, [&] { g_sink += SliceView<T>(seq, n / 4, n / 2)->GetLength(); });
+    SuiteCase("Slice (cut middle)", n, n, reps, [&] { g_sink += Slice<T>(seq, int(n / 4), n / 2)->GetLength(); });
+    SuiteCase("From (8 items)", 8, 8, kSuiteOps / 8, [&] {
+        g_sink += From<T>({ src[0], src[0], src[0], src[0], src[0], src[0], src[0], src[0] })->GetLength();
+    });
+    SuiteCase("Fold", n, n, reps, [&] { g_sink += Fold(seq, 0LL, [](long long a, const T& v) { return a + KeyOf(v); }); });
+    SuiteCase("std::accumulate", n, n, reps, [&] {
+        g_sink += std::accumulate(src.begin(), src.end(), 0LL, [](long long a, const T& v) { return a + KeyOf(v); });
+    });
+    SuiteCase("Where", n, n, reps, [&] { g_sink += Where(seq, keep)->GetLength(); });
+    SuiteCase("std::copy_if", n, n, reps, [&] {
+        std::vector<T> out;
+        std::copy_if(src.begin(), src.end(), std::back_inserter(out), keep);
+        g_sink += out.size();
+    });
+    SuiteCase("Find (last)", n, n, reps, [&] { g_sink += KeyOf(Find(seq, isLast)); });
+    SuiteCase("std::find_if (last)", n, n, reps, [&] { g_sink += KeyOf(*std::find_if(src.begin(), src.end(), isLast)); });
+
+    if constexpr (std::is_arithmetic_v<T>) {
+        const T big = T(500000);
+        SuiteCase("Sum", n, n, reps, [&] { g_sink += static_cast<long long>(Sum(seq)); });
+        SuiteCase("Min", n, n, reps, [&] { g_sink += static_cast<long long>(Min(seq)); });
+        SuiteCase("Max", n, n, reps, [&] { g_sink += static_cast<long long>(Max(seq)); });
+        SuiteCase("CountIfSimd", n, n, reps, [&] { g_sink += CountIfSimd(seq, [big](auto x) { return x > big; }); });
+        SuiteCase("MapSimd", n, n, reps, [&] { g_sink += MapSimd(seq, [](auto x) { return x + x; })->GetLength(); });
+        SuiteCase("WhereSimd", n, n, reps, [&] { g_sink += WhereSimd(seq, [big](auto x) { return x > big; })->GetLength(); });
+        SuiteCase("FindIndexSimd (none)", n, n, reps, [&] { g_sink += FindIndexSimd(seq, [](auto x) { return x < T(0); }); });
+    }
+
+    SuiteCase("ParallelMap", n, n, reps, [&] { g_sink += ParallelMap<T>(seq, [](const T& v) { return v; })->GetLength(); });
+    SuiteCase("ParallelReduce", n, n, reps, [&] {
+        g_sink += ParallelReduce(seq, 0LL, [](long long a, const T& v) { return a + KeyOf(v); }, std::plus<long long>());
+    });
+    SuiteCase("ParallelWhere", n, n, reps, [&] { g_sink += ParallelWhere(seq, keep)->GetLength(); });
+    SuiteCase("ParallelFlatMap", n, n, reps, [&] { g_sink += ParallelFlatMap<T>(seq, single)->GetLength(); });
+
+    // сортировки: каждый проход сортирует свежую копию, копия входит в замер (как и у std)
+    auto sortCase = [&](const char* name, auto sortSeq) {
+        SuiteCase(name, n, n, reps, [&] {
+            MutableArraySequence<T> s(src.data(), n);
+            sortSeq(s);
+            g_sink += KeyOf(s.Get(n / 2));
+        });
+    };
+    auto stdCase = [&](const char* name, auto sortVec) {
+        SuiteCase(name, n, n, reps, [&] {
+            std::vector<T> v = src;
+            sortVec(v);
+            g_sink += KeyOf(v[n / 2]);
+        });
+    };
+    sortCase("Sort", [](auto& s) { Sort(s); });
+    stdCase("std::sort", [](auto& v) { std::sort(v.begin(), v.end()); });
+    sortCase("StableSort", [](auto& s) { StableSort(s); });
+    stdCase("std::stable_sort", [](auto& v) { std::stable_sort(v.begin(), v.end()); });
+    sortCase("PartialSort n/10", [n](auto& s) { PartialSort(s, n / 10); });
+    stdCase("std::partial_sort n/10", [n](auto& v) { std::partial_sort(v.begin(), v.begin() + n / 10, v.end()); });
+    sortCase("NthElement n/2", [n](auto& s) { NthElement(s, n / 2); });
+    stdCase("std::nth_element n/2", [n](auto& v) { std::nth_element(v.begin(), v.begin() + n / 2, v.end()); });
+    sortCase("ParallelSort", [](auto& s) { ParallelSort(s); });
+    sortCase("ParallelStableSort", [](auto& s) { ParallelStableSort(s); });
+    if constexpr (std::is_arithmetic_v<T>) {
+        sortCase("RadixSort", [](auto& s) { RadixSort(s); });
+        sortCase("RadixSortMsd", [](auto& s) { RadixSortMsd(s); });
+    } else if constexpr (std::is_same_v<T, PersonRec>) {
+        auto id = [](const PersonRec& p) { return std::make_pair(p.series, p.number); };
+        sortCase("RadixSort by PersonID", [id](auto& s) { RadixSort(s, id); });
+        sortCase("RadixSortMsd by PersonID", [id](auto& s) { RadixSortMsd(s, id); });
+    }
+}
+
+template<class T>
+void SuiteType() {
+    g_type = TypeName<T>();
+    for (size_t n = 100; n <= g_maxN; n *= 10) {
+        std::printf("-- %zu %s\n", n, g_type);
+        std::vector<T> src(n);
+        for (size_t i = 0; i < n; ++i) src[i] = MakeValue<T>(i);
+        const size_t reps = std::max<size_t>(1, kSuiteOps / n);
+        SuiteContainers(src, reps);
+        SuiteAdapters(src, reps);
+        SuiteAlgorithms(src, reps);
+    }
+    g_type = "";
+}
+
+void BenchSuite() {
+    SuiteType<int>();
+    SuiteType<double>();
+    SuiteType<std::string>();
+    SuiteType<PersonRec>();
+}
+
+// ----------------- 25) Счётчики контейнеров: что сделала каждая нагрузка (сборка с -DSEQ_STATS) -------------------
+void BenchStats() {
+    if (!stats::kEnabled) { std::printf("stats: build with -DSEQ_STATS\n"); return; }
+    const size_t n = 100000;
+    auto show = [](const char* name, const std::string& json) { std::printf("%-28s %s\n", name, json.c_str()); };
+
+    stats::Reset();
+    Queue<int> q;
+    for (size_t i = 0; i < n; ++i) q.Enqueue(int(i));
+    while (q.Size()) g_sink += q.Dequeue();
+    show("Queue drain", q.Stats().Json());
+
+    MutableArraySequence<int> fifo;                      // очередь на PopFront массива: каждый сдвигает хвост
+    for (size_t i = 0; i < n / 10; ++i) fifo.Append(int(i));
+    while (fifo.GetLength()) g_sink += fifo.PopFront();
+    show("ArraySeq PopFront drain", stats::Global<stats::ArrayKind>().Json());
+
+    ImmutableArraySequence<int> im;
+    SeqUPtr<int> cur = im.Clone();
+    for (size_t i = 0; i < 1000; ++i) cur = static_cast<const Sequence<int>&>(*cur).Append(int(i));
+    MutableArraySequence<int> arr;
+    for (size_t i = 0; i < n; ++i) arr.Append(int(i));
+    for (size_t i = 0; i < 100; ++i) { auto w = arr.GetSubsequence(0, 9); arr.Append(int(i)); }
+    show("ArraySeq subseq+write", arr.Stats().Json());
+    show("global", stats::DumpJson());
+}
+
+// ----------------- 26) Массив в файле: открытие не зависит от размера, обход с подсказками -------------------
+void BenchMapped() {
+    const std::string path = "/tmp/laba3_bench_mapped_" + std::to_string(::getpid()) + ".bin";
+    for (size_t n = 100000; n <= g_maxN * 10; n *= 10) {
+        {
+            auto a = DynamicArray<int>::Mapped(path, mapped::Mode::Create, n);
+            Report("Mapped fill+checkpoint", n, MeasureMs([&] {
+                for (size_t i = 0; i < n; ++i) a.PushBack(int(i));
+                a.Checkpoint();
+            }));
+        }
+        double ms = MeasureMs([&] {
+            MutableArraySequence<int> seq(DynamicArray<int>::Mapped(path));
+            g_sink += seq.GetLength();
+        });
+        Report("Mapped reopen", 1, ms, n);                // на один файл, n — его длина
+
+        auto a = DynamicArray<int>::Mapped(path, mapped::Mode::ReadOnly);
+        Report("Mapped scan (sequential)", n, MeasureMs([&] {
+            long long s = 0;
+            for (size_t i = 0; i < n; ++i) s += a.GetUnchecked(i);
+            g_sink += s;
+        }));
+        a.Advise(mapped::Advice::Random);
+        uint64_t x = 88172645463325252ull;
+        Report("Mapped Get random", n, MeasureMs([&] {
+            long long s = 0;
+            for (size_t i = 0; i < n; ++i) { x ^= x << 13; x ^= x >> 7; x ^= x << 17; s += a.GetUnchecked(x % n); }
+            g_sink += s;
+        }));
+    }
+    std::remove(path.c_str());
+}
+
+// ----------------- Вывод: CSV / JSON -------------------
+
+// строка в кавычках; имена замеров — ASCII без управляющих символов
+std::string Quoted(const std::string& s) {
+    std::string q = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') q += '\\';
+        q += c;
+    }
+    return q + '"';
+}
+
+double OpsPerSec(const Result& r) { return r.ms > 0 ? r.ops / (r.ms * 1e-3) : 0.0; }
+
+bool WriteCsv(const char* path) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "section,name,type,size,ops,ms,ns_per_op,ops_per_s,allocs_per_op\n";
+    for (const auto& r : g_results)
+        out << r.section << ',' << Quoted(r.name) << ',' << r.type << ',' << r.size << ',' << r.ops << ','
+            << r.ms << ',' << r.ms * 1e6 / r.ops << ',' << OpsPerSec(r) << ',' << r.allocsPerOp << '\n';
+    return bool(out);
+}
+
+bool WriteJson(const char* path) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "[\n";
+    for (size_t i = 0; i < g_results.size(); ++i) {
+        const auto& r = g_results[i];
+        out << "  {\"section\": " << Quoted(r.section) << ", \"name\": " << Quoted(r.name)
+            << ", \"type\": " << Quoted(r.type) << ", \"size\": " << r.size << ", \"ops\": " << r.ops
+            << ", \"ms\": " << r.ms << ", \"ns_per_op\": " << r.ms * 1e6 / r.ops
+            << ", \"ops_per_s\": " << OpsPerSec(r) << ", \"allocs_per_op\": " << r.allocsPerOp << '}'
+            << (i + 1 < g_results.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+    return bool(out);
+}
+
+struct Section { const char* name; void (*run)(); };
+
+const Section kSections[] = {
+    { "drain",        BenchDrain },
+    { "steady-queue", BenchSteadyQueue },
+    { "concurrent",   BenchConcurrentQueues },
+    { "dijkstra",     BenchDijkstra },
+    { "heap-load",    BenchHeapLoad },
+    { "pushback",     BenchPushBack },
+    { "small-seq",    BenchSmallSequences },
+    { "node-pool",    BenchNodePool },
+    { "list-backends", BenchListBackends },
+    { "chunked",      BenchChunkedAlgorithms },
+    { "simd",         BenchSimd },
+    { "parallel",     BenchParallelScaling },
+    { "pipelines",    BenchPipelines },
+    { "persistent",   BenchPersistent },
+    { "persistent-list", BenchPersistentList },
+    { "slices",       BenchSlices },
+    { "rope",         BenchRope },
+    { "copy-move",    BenchCopyMove },
+    { "ranges",       BenchRanges },
+    { "bounds",       BenchBounds },
+    { "sort",         BenchSort },
+    { "radix",        BenchRadix },
+    { "suite",        BenchSuite },
+    { "stats",        BenchStats },
+    { "mapped",       BenchMapped },
+};
+
+void Usage() {
+    std::printf("usage: bench [--only s1,s2,...] [--max-n N] [--csv FILE] [--json FILE] [--list]\n");
+}
+
+int main(int argc, char** argv) {
+    std::string only;
+    const char* csv = nullptr;
+    const char* json = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--list") {
+            for (const auto& s : kSections) std::printf("%s\n", s.name);
+            return 0;
+        }
+        if (a == "--only" && hasValue) only = "," + std::string(argv[++i]) + ",";
+        else if (a == "--max-n" && hasValue) g_maxN = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--csv" && hasValue) csv = argv[++i];
+        else if (a == "--json" && hasValue) json = argv[++i];
+        else { Usage(); return 2; }
+    }
+    for (const auto& s : kSections) {
+        if (!only.empty() && only.find("," + std::string(s.name) + ",") == std::string::npos) continue;
+        std::printf("== %s\n", s.name);
+        g_section = s.name;
+        s.run();
+    }
+    if (csv && !WriteCsv(csv)) { std::perror(csv); return 1; }
+    if (json && !WriteJson(json)) { std::perror(json); return 1; }
+    return 0;
+}
@@ -1,20 +1,45 @@
 // tests.cpp
+// Сборка: g++ -std=c++17 -O2 -pthread -Wno-psabi tests.cpp -o tests && ./tests
 
 #include "Sequence.hpp"
 #include "MutableArraySequence.hpp"
 #include "MutableListSequence.hpp"
+#include "ImmutableListSequence.hpp"
 #include "DynamicArray.hpp"
+#include "MappedFile.hpp"
 #include "LinkedList.hpp"
+#include "NodePool.hpp"
+#include "UnrolledLinkedList.hpp"
+#include "RingBuffer.hpp"
+#include "CircularArraySequence.hpp"
 #include "Queue.hpp"
 #include "Stack.hpp"
 #include "PriorityQueue.hpp"
+#include "IndexedPriorityQueue.hpp"
 #include "Deque.hpp"
+#include "ConcurrentQueue.hpp"
+#include "SmallArraySequence.hpp"
+#include "PersistentArraySequence.hpp"
+#include "SequenceSlice.hpp"
+#include "RopeSequence.hpp"
+#include "ImmutableArraySequence.hpp"
+#include "Sort.hpp"
+#include "RadixSort.hpp"
+#include "Stats.hpp"
+#include "algorithms.hpp"
 
 #include <iostream>
 #include <cassert>
+#include <cmath>
+#include <cstdio>
 #include <complex>
 #include <string>
+#include <limits>
+#include <list>
 #include <ctime>
+#include <thread>
+#include <atomic>
+#include <vector>
 
 // ----------------- 1) Функции для теста указателей -------------------
 
@@ -176,10 +201,40 @@ struct ComplexWrapper {
     }
 };
 
-// ----------------- 5) Основные тесты -------------------
+// ----------------- 5) Тип без конструктора по умолчанию, считающий живые объекты -------------------
+
+struct Tracked {
+    static std::atomic<int> alive;              // ParallelMap конструирует из пула потоков
+    int v;
+    explicit Tracked(int x) : v(x) { ++alive; }
+    Tracked(const Tracked& o) : v(o.v) { ++alive; }
+    Tracked(Tracked&& o) noexcept : v(o.v) { ++alive; }
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) = default;
+    ~Tracked() { --alive; }
+};
+std::atomic<int> Tracked::alive{0};
+
+// считает копии и переносы — для проверок move-путей
+struct CopyMove {
+    static int copies, moves;
+    std::string s;
+    CopyMove() = default;
+    explicit CopyMove(std::string x) : s(std::move(x)) {}
+    CopyMove(size_t n, char c) : s(n, c) {}
+    CopyMove(const CopyMove& o) : s(o.s) { ++copies; }
+    CopyMove(CopyMove&& o) noexcept : s(std::move(o.s)) { ++moves; }
+    CopyMove& operator=(const CopyMove& o) { s = o.s; ++copies; return *this; }
+    CopyMove& operator=(CopyMove&& o) noexcept { s = std::move(o.s); ++moves; return *this; }
+    bool operator<(const CopyMove& o) const { return s < o.s; }
+    static void Reset() { copies = moves = 0; }
+};
+int CopyMove::copies = 0, CopyMove::moves = 0;
+
+// ----------------- 6) Основные тесты -------------------
 
 int main() {
-    // --- 5.1 Тесты для целых чисел (int) ---
+    // --- 6.1 Тесты для целых чисел (int) ---
     {
         Queue<int> q_int;
         q_int.Enqueue(10);
@@ -220,7 +275,7 @@ int main() {
         assert(p3 == 1);
     }
 
-    // --- 5.2 Тесты для вещественных чисел (double) ---
+    // --- 6.2 Тесты для вещественных чисел (double) ---
     {
         Queue<double> q_double;
         q_double.Enqueue(1.5);
@@ -252,7 +307,7 @@ int main() {
         assert(dp3 == 1.1);
     }
 
-    // --- 5.3 Тесты для комплексных чисел (std::complex<double>) через ComplexWrapper ---
+    // --- 6.3 Тесты для комплексных чисел (std::complex<double>) через ComplexWrapper ---
     {
         using cd = std::complex<double>;
         Queue<cd> q_cmplx;
@@ -285,7 +340,7 @@ int main() {
         assert(topc == ComplexWrapper(cd(0.0, 3.0)));
     }
 
-    // --- 5.4 Тесты для строк и символов (std::string, char) ---
+    // --- 6.4 Тесты для строк и символов (std::string, char) ---
     {
         Queue<std::string> q_str;
         q_str.Enqueue("Hello");
@@ -316,7 +371,7 @@ int main() {
         assert(pq_str.Pop() == "apple");
     }
 
-    // --- 5.5 Тесты для указателей на функции (int(*)(int)) ---
+    // --- 6.5 Тесты для указателей на функции (int(*)(int)) ---
     {
         // Используем Deque для демонстрации. Можно использовать любую другую ADT.
         Deque<int(*)(int)> d_fun;
@@ -337,7 +392,7 @@ int main() {
         assert(q_fun.Dequeue()(5) == 8); // 5+3
     }
 
-    // --- 5.6 Тесты для Student (3 экземпляра) ---
+    // --- 6.6 Тесты для Student (3 экземпляра) ---
     {
         // Создаём трёх студентов
         Student st1(
@@ -390,7 +445,7 @@ int main() {
         assert(ds3.GetID().number == 1003);
     }
 
-    // --- 5.7 Тесты для Teacher (3 экземпляра) ---
+    // --- 6.7 Тесты для Teacher (3 экземпляра) ---
     {
         Teacher t1(
             PersonID{20, 2001},
@@ -438,7 +493,1525 @@ int main() {
         assert(dt3.GetID().number == 2003);
     }
 
-    // --- 5.8 Вывод результата, если все assert-ы прошли ---
+    // --- 6.8 Удаление из последовательностей (PopBack/PopFront/RemoveAt/EraseRange) ---
+    {
+        int raw[] = {1, 2, 3, 4, 5, 6};
+        MutableArraySequence<int> arr(raw, 6);
+        MutableListSequence<int>  lst(raw, 6);
+        Sequence<int>* seqs[] = {&arr, &lst};
+        for (Sequence<int>* s : seqs) {
+            assert(s->PopBack() == 6);
+            assert(s->PopFront() == 1);
+            assert(s->RemoveAt(1) == 3);          // 2 4 5
+            assert(s->GetLength() == 3);
+            s->EraseRange(0, 1);                  // 5
+            assert(s->GetLength() == 1 && s->GetFirst() == 5 && s->GetLast() == 5);
+            assert(s->PopBack() == 5);
+            assert(s->GetLength() == 0);
+            s->Append(7);
+            assert(s->GetFirst() == 7 && s->GetLast() == 7);
+        }
+
+        Queue<std::string> q;
+        for (int i = 0; i < 1000; ++i) q.Enqueue(std::to_string(i));
+        for (int i = 0; i < 1000; ++i) assert(q.Dequeue() == std::to_string(i));
+        assert(q.Size() == 0);
+    }
+
+    // --- 6.9 RingBuffer / CircularArraySequence: переход через границу и рост ---
+    {
+        RingBuffer<int> rb;
+        for (int i = 0; i < 6; ++i) rb.PushBack(i);          // 0..5
+        for (int i = 0; i < 4; ++i) assert(rb.PopFront() == i);
+        for (int i = 6; i < 12; ++i) rb.PushBack(i);         // голова у конца буфера, хвост завернулся
+        rb.PushFront(3);                                     // 3..11
+        assert(rb.GetCapacity() == 16 && rb.GetSize() == 9);
+        for (size_t i = 0; i < rb.GetSize(); ++i) assert(rb[i] == int(i) + 3);
+        rb.InsertAt(100, 1);                                 // 3 100 4 ..
+        rb.InsertAt(200, 9);                                 // .. 10 200 11
+        assert(rb[1] == 100 && rb[9] == 200 && rb[10] == 11);
+        assert(rb.RemoveAt(1) == 100 && rb.RemoveAt(8) == 200);
+        rb.Erase(0, 1);                                      // 5..11
+        rb.Erase(5, 6);                                      // 5..9
+        assert(rb.GetSize() == 5 && rb[0] == 5 && rb[4] == 9);
+
+        CircularArraySequence<std::string> cs;
+        for (int i = 0; i < 100; ++i) {
+            cs.Prepend(std::to_string(-i - 1));
+            cs.Append(std::to_string(i));
+        }
+        assert(cs.GetLength() == 200 && cs.GetFirst() == "-100" && cs.GetLast() == "99");
+        auto sub = cs.GetSubsequence(99, 100);
+        assert(sub->GetLength() == 2 && sub->Get(0) == "-1" && sub->Get(1) == "0");
+        int expect = -100;
+        for (const auto& v : cs) { assert(v == std::to_string(expect)); ++expect; }
+        assert(cs.PopFront() == "-100" && cs.PopBack() == "99");
+
+        Deque<int> d;
+        for (int i = 0; i < 1000; ++i) d.PushFront(i);
+        for (int i = 0; i < 1000; ++i) assert(d.PopBack() == i);
+
+        // аргумент — элемент того же кольца: рост и сдвиг не должны его испортить
+        CircularArraySequence<std::string> full;
+        for (int i = 0; i < 8; ++i) full.Append("s" + std::to_string(i));
+        full.Append(full.Get(0));                            // полное кольцо: рост
+        assert(full.GetLength() == 9 && full.GetLast() == "s0");
+        full.InsertAt(full.Get(8), 2);                       // сдвиг левой части
+        full.InsertAt(full.Get(1), 7);                       // сдвиг правой части
+        assert(full.Get(2) == "s0" && full.Get(7) == "s1" && full.Get(3) == "s2");
+        CircularArraySequence<std::string> self;                // кольцо с переходом через границу
+        for (int i = 0; i < 6; ++i) self.Append(std::to_string(i));
+        self.PopFront(); self.PopFront(); self.Append("6"); self.Append("7");
+        self.Concat(&self);                                  // сам с собой — ровно удвоение
+        assert(self.GetLength() == 12 && self.Get(0) == "2" && self.Get(5) == "7");
+        assert(self.Get(6) == "2" && self.GetLast() == "7");
+        RingBuffer<std::string> rs;
+        for (int i = 0; i < 8; ++i) rs.PushBack(std::to_string(i));
+        rs.PushFront(rs[7]);
+        assert(rs.GetSize() == 9 && rs[0] == "7" && rs[8] == "7");
+        Deque<std::string> ds;
+        for (int i = 0; i < 8; ++i) ds.PushBack(std::to_string(i));
+        ds.PushBack(ds.Front());
+        assert(ds.Back() == "0" && ds.Front() == "0");
+
+        // T без конструктора по умолчанию; снятый элемент разрушается сразу
+        struct NoDefault { std::shared_ptr<int> p; explicit NoDefault(std::shared_ptr<int> q) : p(std::move(q)) {} };
+        auto token = std::make_shared<int>(1);
+        RingBuffer<NoDefault> nd;
+        for (int i = 0; i < 5; ++i) nd.EmplaceBack(token);
+        nd.EmplaceFront(token);
+        nd.InsertAt(NoDefault(token), 3);
+        assert(token.use_count() == 8);
+        nd.PopBack(); nd.PopFront(); nd.RemoveAt(2); nd.Erase(0, 1);
+        assert(nd.GetSize() == 2 && token.use_count() == 3);
+        { RingBuffer<NoDefault> cp(nd); assert(token.use_count() == 5); }
+        assert(token.use_count() == 3);
+    }
+
+    // --- 6.10 SpscQueue / MpmcQueue ---
+    {
+        SpscQueue<int> sq(3);                                // ёмкость округляется до 4
+        assert(sq.Capacity() == 4);
+        for (int i = 0; i < 4; ++i) assert(sq.TryEnqueue(i));
+        assert(!sq.TryEnqueue(99) && sq.Size() == 4);
+        int x = -1;
+        assert(sq.TryDequeue(x) && x == 0);
+        assert(sq.TryEnqueue(4));
+        for (int i = 1; i <= 4; ++i) assert(sq.Dequeue() == i);
+        assert(!sq.TryDequeue(x));
+
+        const int n = 100000;
+        SpscQueue<int> sq2(64);
+        long long got = 0;
+        std::atomic<bool> running{true};
+        std::atomic<size_t> maxSeen{0};
+        std::thread watch([&] {                              // Size() из третьего потока — оценка, но без переполнения
+            while (running) maxSeen = std::max<size_t>(maxSeen, sq2.Size());
+        });
+        std::thread prod([&] { for (int i = 0; i < n; ++i) sq2.Enqueue(i); });
+        for (int i = 0; i < n; ++i) { int v = sq2.Dequeue(); assert(v == i); got += v; }
+        prod.join();
+        running = false;
+        watch.join();
+        assert(maxSeen <= size_t(n));
+        assert(got == (long long)n * (n - 1) / 2);
+
+        MpmcQueue<std::string> mq(2);
+        assert(mq.TryEnqueue("a") && mq.TryEnqueue("b") && !mq.TryEnqueue("c"));
+        assert(mq.Dequeue() == "a" && mq.Size() == 1);
+
+        MpmcQueue<int> mq2(128);
+        std::vector<std::thread> ths;
+        std::vector<long long> sums(2, 0);
+        for (int p = 0; p < 2; ++p)
+            ths.emplace_back([&, p] { for (int i = p; i < n; i += 2) mq2.Enqueue(i); });
+        for (int c = 0; c < 2; ++c)
+            ths.emplace_back([&, c] { for (int i = 0; i < n / 2; ++i) sums[c] += mq2.Dequeue(); });
+        for (auto& t : ths) t.join();
+        assert(sums[0] + sums[1] == (long long)n * (n - 1) / 2 && mq2.Size() == 0);
+    }
+
+    // --- 6.11 IndexedPriorityQueue: Update / DecreaseKey / Erase по хэндлу ---
+    {
+        IndexedPriorityQueue<int> pq;                        // max-куча, 4-арная
+        using H = IndexedPriorityQueue<int>::Handle;
+        std::vector<H> hs;
+        for (int i = 0; i < 20; ++i) hs.push_back(pq.Push(i * 10));
+        assert(pq.Top() == 190);
+        pq.Update(hs[0], 500);                               // поднялся на вершину
+        pq.Update(hs[19], -5);                               // ушёл вниз
+        assert(pq.Erase(hs[10]) == 100);
+        assert(!pq.Contains(hs[10]) && pq.Size() == 19);
+        pq.DecreaseKey(hs[5], 185);                          // 50 -> 185, только вверх
+        bool thrown = false;
+        try { pq.DecreaseKey(hs[6], 0); } catch (const std::invalid_argument&) { thrown = true; }
+        assert(thrown);
+        assert(pq.Get(hs[5]) == 185);
+
+        int expected[] = {500, 185, 180, 170, 160, 150, 140, 130, 120, 110,
+                          90, 80, 70, 60, 40, 30, 20, 10, -5};
+        for (int e : expected) assert(pq.Pop() == e);
+        assert(pq.Size() == 0);
+
+        // min-куча для Дейкстры, 8-арная
+        IndexedPriorityQueue<int, std::greater<int>, 8> mq;
+        auto a = mq.Push(10); mq.Push(7); auto c = mq.Push(12);
+        mq.DecreaseKey(c, 1);
+        mq.DecreaseKey(a, 5);
+        assert(mq.Pop() == 1 && mq.Pop() == 5 && mq.Pop() == 7);
+
+        // номер освобождённого хэндла переиспользуется, но старый хэндл — уже нет
+        IndexedPriorityQueue<int> rq;
+        H old = rq.Push(1);
+        assert(rq.Pop() == 1);
+        H fresh = rq.Push(2);
+        assert(fresh.id == old.id && !rq.Contains(old) && rq.Contains(fresh) && !rq.Contains(H{}));
+        int stale = 0;
+        try { rq.Update(old, 100); } catch (const std::out_of_range&) { ++stale; }
+        try { rq.Erase(old); } catch (const std::out_of_range&) { ++stale; }
+        try { rq.DecreaseKey(old, 50); } catch (const std::out_of_range&) { ++stale; }
+        assert(stale == 3 && rq.Size() == 1 && rq.Top() == 2);
+        assert(rq.Erase(fresh) == 2 && !rq.Contains(fresh));
+    }
+
+    // --- 6.12 PriorityQueue: построение кучей, PushRange, PopN ---
+    {
+        int raw[] = {5, 1, 9, 3, 7, 2, 8};
+        PriorityQueue<int> pq(raw, raw + 7);
+        assert(pq.Size() == 7 && pq.Pop() == 9);
+
+        MutableArraySequence<int> more(raw, 3);              // 5 1 9
+        pq.PushRange(more);
+        int small[] = {10};
+        pq.PushRange(small, small + 1);                      // маленькая пачка — через push_heap
+        int top[4];
+        assert(pq.PopN(4, top) == 4);
+        assert(top[0] == 10 && top[1] == 9 && top[2] == 8 && top[3] == 7);
+
+        std::vector<int> rest;
+        assert(pq.PopN(100, std::back_inserter(rest)) == 6 && pq.Size() == 0);
+        int expect[] = {5, 5, 3, 2, 1, 1};
+        for (size_t i = 0; i < rest.size(); ++i) assert(rest[i] == expect[i]);
+
+        MutableListSequence<std::string> words;
+        words.Append("pear"); words.Append("apple"); words.Append("zebra");
+        PriorityQueue<std::string, std::greater<std::string>> minq(words);
+        assert(minq.Pop() == "apple" && minq.Pop() == "pear" && minq.Pop() == "zebra");
+    }
+
+    // --- 6.13 DynamicArray: сырая память, политики роста ---
+    {
+        {
+            DynamicArray<Tracked> a;                          // T без конструктора по умолчанию
+            for (int i = 0; i < 10; ++i) a.PushBack(Tracked(i));
+            assert(Tracked::alive == 10 && a.GetCapacity() == 16);
+            a.Reserve(100);                                   // ёмкость не создаёт объектов
+            assert(Tracked::alive == 10);
+            a.PushBack(a[0]);                                 // ссылка внутрь себя
+            assert(a[10].v == 0);
+            assert(a.RemoveAt(2).v == 2);
+            assert(Tracked::alive == 10);
+            a.Erase(0, 3);                                    // 5 6 7 8 9 0
+            assert(Tracked::alive == 6 && a.GetSize() == 6 && a[0].v == 5);
+            assert(a.PopBack().v == 0);
+            assert(Tracked::alive == 5);
+            DynamicArray<Tracked> b(a);
+            assert(Tracked::alive == 10 && b[4].v == 9);
+        }
+        assert(Tracked::alive == 0);
+
+        DynamicArray<std::string, GrowOneAndHalf> s;
+        size_t caps[8], k = 0, last = 0;
+        for (int i = 0; i < 20; ++i) {
+            s.PushBack(std::string(30, char('a' + i)));
+            if (s.GetCapacity() != last && k < 8) caps[k++] = last = s.GetCapacity();
+        }
+        assert(caps[0] == 1 && caps[1] == 2 && caps[2] == 3 && caps[3] == 4 && caps[4] == 6);
+        s.Erase(1, 18);
+        assert(s.GetSize() == 2 && s[1] == std::string(30, 't'));
+        s.Resize(4);
+        assert(s[3].empty());
+
+        DynamicArray<int> ints;
+        for (int i = 0; i < 100; ++i) ints.PushBack(i);
+        ints.Erase(10, 89);                                   // memmove
+        assert(ints.GetSize() == 20 && ints[10] == 90 && ints.RemoveAt(0) == 0 && ints[0] == 1);
+    }
+
+    // --- 6.14 SmallDynamicArray / SmallArraySequence, Split<N>, FlatMap<U, Out> ---
+    {
+        SmallDynamicArray<std::string, 3> a;
+        a.PushBack("x"); a.PushBack("y");
+        assert(a.IsInline() && a.GetCapacity() == 3);
+        SmallDynamicArray<std::string, 3> b(std::move(a));  // inline: элементы переезжают
+        assert(b.GetSize() == 2 && b[1] == "y" && a.GetSize() == 0);
+        b.PushBack("z"); b.PushBack("w");                    // переполнение -> куча
+        assert(!b.IsInline() && b.GetSize() == 4 && b[0] == "x" && b[3] == "w");
+        a = b;
+        SmallDynamicArray<std::string, 3> c(std::move(b));   // куча: забираем буфер
+        assert(!c.IsInline() && c[2] == "z" && b.IsInline() && b.GetSize() == 0);
+        c.Erase(0, 2);
+        assert(c.GetSize() == 1 && c[0] == "w");
+        a.swap(c);
+        assert(a.GetSize() == 1 && c.GetSize() == 4);
+
+        SmallArraySequence<int, 4> ss;
+        ss.Append(2); ss.Prepend(1); ss.InsertAt(9, 1);      // 1 9 2
+        assert(ss.Get(0) == 1 && ss.Get(1) == 9 && ss.Get(2) == 2 && ss.IsInline());
+        assert(ss.PopFront() == 1 && ss.GetLength() == 2);
+        ss.Concat(&ss); ss.Concat(&ss);                      // 9 2 ×4: выход из inline посреди Concat
+        assert(ss.GetLength() == 8 && !ss.IsInline() && ss.Get(6) == 9 && ss.GetLast() == 2);
+
+        int raw[] = {1, 2, 0, 3, 0, 0, 4, 5, 6, 7, 8, 0, 9};
+        MutableArraySequence<int> src(raw, 13);
+        auto parts = Split<4>(src, [](int v) { return v == 0; });
+        assert(parts->GetLength() == 4);
+        assert(parts->Get(0).GetLength() == 2 && parts->Get(0).IsInline());
+        assert(parts->Get(2).GetLength() == 5 && !parts->Get(2).IsInline());
+        assert(parts->Get(2).GetLast() == 8 && parts->Get(3).GetFirst() == 9);
+
+        auto fm = src.FlatMap<int, SmallArraySequence<int, 16>>([](int v) {
+            auto sub = SeqUPtr<int>(new SmallArraySequence<int, 2>());
+            if (v) { sub->Append(v); sub->Append(-v); }
+            return sub;
+        });
+        assert(fm->GetLength() == 18 && fm->Get(1) == -1 && fm->GetLast() == -9);
+    }
+
+    // --- 6.15 LinkedList на пуле узлов ---
+    {
+        NodePool<int> pool;                                  // сам пул: свободный список и слэбы
+        int* p1 = pool.New(1);
+        int* p2 = pool.New(2);
+        pool.Delete(p1);
+        int* p3 = pool.New(3);
+        assert(p3 == p1 && *p2 == 2 && pool.SlabCount() == 1);
+        for (int i = 0; i < 200; ++i) pool.New(i);           // 64 + 128 + 256
+        assert(pool.SlabCount() == 3);
+        pool.Release();
+        assert(pool.SlabCount() == 0);
+
+        {
+            LinkedList<Tracked, NodePool> tl;
+            for (int i = 0; i < 100; ++i) tl.Append(Tracked(i));
+            tl.Erase(10, 89);
+            assert(tl.GetLength() == 20 && Tracked::alive == 20);
+            LinkedList<Tracked, NodePool> moved(std::move(tl));
+            assert(moved.Get(10).v == 90 && tl.GetLength() == 0);
+        }
+        assert(Tracked::alive == 0);                         // деструкторы отработали до Release
+
+        using PooledList = LinkedList<std::string, NodePool>;
+        MutableListSequence<std::string, PooledList> ls;
+        for (int i = 0; i < 1000; ++i) ls.Append(std::to_string(i));
+        ls.Prepend("head");
+        assert(ls.PopFront() == "head" && ls.RemoveAt(500) == "500");
+        ls.InsertAt("x", 1);
+        assert(ls.GetLength() == 1000 && ls.Get(1) == "x" && ls.GetLast() == "999");
+        auto cl = ls.Clone();
+        assert(cl->Get(501) == "501");
+        auto sub = ls.GetSubsequence(0, 1);
+        assert(sub->GetLength() == 2 && sub->Get(0) == "0");
+
+        const ImmutableListSequence<int, LinkedList<int, NodePool>> il;
+        auto il1 = il.Append(1);
+        auto il2 = static_cast<const Sequence<int>&>(*il1).Append(2);
+        assert(il.GetLength() == 0 && il2->GetLength() == 2 && il2->GetLast() == 2);
+    }
+
+    // --- 6.16 UnrolledLinkedList: сверка со std::vector на случайных операциях ---
+    {
+        UnrolledLinkedList<int, 4> ul;                       // маленький блок — чаще деления/слияния
+        std::vector<int> ref;
+        unsigned rnd = 12345;
+        auto next = [&rnd] { rnd = rnd * 1103515245u + 12345u; return rnd >> 8; };
+        for (int step = 0; step < 5000; ++step) {
+            unsigned op = next() % 8;
+            if (op < 2 || ref.empty()) {
+                size_t i = next() % (ref.size() + 1);
+                ul.InsertAt(step, i); ref.insert(ref.begin() + i, step);
+            } else if (op == 2) {
+                ul.Prepend(step); ref.insert(ref.begin(), step);
+            } else if (op == 3) {
+                ul.Append(step); ref.push_back(step);
+            } else if (op == 4) {
+                size_t i = next() % ref.size();
+                assert(ul.RemoveAt(i) == ref[i]); ref.erase(ref.begin() + i);
+            } else if (op == 5) {
+                assert(ul.PopFront() == ref.front()); ref.erase(ref.begin());
+            } else if (op == 6) {
+                assert(ul.PopBack() == ref.back()); ref.pop_back();
+            } else {
+                size_t l = next() % ref.size(), r = l + next() % 3;
+                if (r >= ref.size()) r = ref.size() - 1;
+                ul.Erase(l, r); ref.erase(ref.begin() + l, ref.begin() + r + 1);
+            }
+            assert(ul.GetLength() == ref.size());
+            if (!ref.empty()) {
+                size_t i = next() % ref.size();
+                assert(ul.Get(i) == ref[i] && ul.GetFirst() == ref.front() && ul.GetLast() == ref.back());
+            }
+        }
+        size_t k = 0;
+        for (int v : ul) assert(v == ref[k++]);
+        assert(k == ref.size());
+
+        {
+            UnrolledLinkedList<Tracked, 3> ut;
+            for (int i = 0; i < 10; ++i) ut.InsertAt(Tracked(i), i / 2);
+            ut.Erase(2, 6);
+            assert(Tracked::alive == 5);
+            UnrolledLinkedList<Tracked, 3> copy(ut);
+            assert(Tracked::alive == 10 && copy.GetLast().v == ut.GetLast().v);
+        }
+        assert(Tracked::alive == 0);
+
+        // аргумент — элемент того же списка: сдвиг и деление узла его не портят
+        UnrolledLinkedList<int, 8> ua;
+        for (int i = 0; i < 6; ++i) ua.Append(i);
+        ua.InsertAt(ua.Get(5), 3);                           // 0 1 2 5 3 4 5
+        ua.Prepend(ua.Get(1));                               // 1 0 1 2 5 3 4 5 — узел полон
+        ua.InsertAt(ua.Get(7), 6);                           // деление узла
+        ua.Prepend(ua.GetFirst());
+        const int want[] = { 1, 1, 0, 1, 2, 5, 3, 5, 4, 5 };
+        assert(ua.GetLength() == 10);
+        for (size_t i = 0; i < 10; ++i) assert(ua.Get(i) == want[i]);
+
+        // конструктор бросил — щель в узле закрыта, список цел
+        struct Picky { int v; explicit Picky(int x) : v(x) { if (x < 0) throw std::invalid_argument("neg"); } };
+        UnrolledLinkedList<Picky, 4> up;
+        for (int i = 0; i < 3; ++i) up.EmplaceBack(i);
+        int thrown = 0;
+        try { up.Emplace(1, -1); } catch (const std::invalid_argument&) { ++thrown; }
+        try { up.EmplaceFront(-1); } catch (const std::invalid_argument&) { ++thrown; }
+        assert(thrown == 2 && up.GetLength() == 3 && up.Get(0).v == 0 && up.Get(1).v == 1 && up.Get(2).v == 2);
+
+        using UL = UnrolledLinkedList<std::string, 4>;
+        MutableListSequence<std::string, UL> ms;
+        for (int i = 0; i < 20; ++i) ms.Append(std::to_string(i));
+        ms.InsertAt("mid", 10);
+        auto sub = ms.GetSubsequence(9, 11);
+        assert(sub->GetLength() == 3 && sub->Get(1) == "mid" && sub->Get(2) == "10");
+        const ImmutableListSequence<std::string, UL> is;
+        auto is2 = is.Prepend("b");
+        auto is3 = static_cast<const Sequence<std::string>&>(*is2).Prepend("a");
+        assert(is.GetLength() == 0 && is3->GetLength() == 2 && is3->GetFirst() == "a");
+    }
+
+    // --- 6.17 Блочный обход: NextChunk / ForEachChunk / алгоритмы поверх него ---
+    {
+        const size_t n = 100000;
+        MutableListSequence<long long> ls;
+        MutableListSequence<long long, UnrolledLinkedList<long long, 64>> us;
+        MutableArraySequence<long long> as;
+        CircularArraySequence<long long> cs;
+        for (size_t i = 0; i < n; ++i) {
+            ls.Append(i); us.Append(i); as.Append(i);
+        }
+        for (size_t i = n / 2; i < n; ++i) cs.Append(i);
+        for (size_t i = n / 2; i > 0; --i) cs.Prepend(i - 1); // голова завернулась к концу буфера
+        cs.Prepend(-1);
+        const long long expect = (long long)n * (n - 1) / 2;
+        auto add = [](long long a, long long b) { return a + b; };
+        assert(ls.Reduce(0LL, add) == expect);              // раньше — O(n^2) через Get(i)
+        assert(us.Reduce(0LL, add) == expect && as.Reduce(0LL, add) == expect);
+        assert(cs.Reduce(0LL, add) == expect - 1);
+
+        size_t chunks = 0;
+        auto count = [&chunks](const long long*, size_t) { ++chunks; return true; };
+        as.ForEachChunk(count); assert(chunks == 1);
+        chunks = 0; us.ForEachChunk(count); assert(chunks == n / 64 + 1);
+        chunks = 0; ls.ForEachChunk(count); assert(chunks == n);
+        chunks = 0; cs.ForEachChunk(count); assert(chunks == 2);
+
+        long long k = 0;
+        for (long long v : static_cast<const Sequence<long long>&>(us)) assert(v == k++);
+        assert(k == (long long)n);
+        k = -1;
+        for (long long v : static_cast<const Sequence<long long>&>(cs)) { assert(v == k); k = k < 0 ? 0 : k + 1; }
+        assert(k == (long long)n);
+
+        auto hit = ls.TryFirst([](long long v) { return v > 99990; });
+        assert(hit && *hit == 99991);
+        auto evens = us.Where([](long long v) { return v % 2 == 0; });
+        assert(evens->GetLength() == n / 2 && evens->GetLast() == (long long)n - 2);
+        auto sq = ls.Map<long long>([](long long v) { return v * v; });
+        assert(sq->Get(300) == 90000);
+
+        auto zipped = Zip<long long, long long>(ls, *sq);
+        assert(zipped->GetLength() == n && zipped->Get(7).second == 49);
+        auto [za, zb] = Unzip(*zipped);
+        assert(za->Get(99999) == 99999 && zb->Get(3) == 9);
+
+        long long r[] = {7, 8};
+        MutableListSequence<long long> repl(r, 2);
+        auto sl = Slice<long long>(ls, 2, 99990, &repl);     // 0 1 7 8 99992..99999
+        assert(sl->GetLength() == 12 && sl->Get(2) == 7 && sl->Get(4) == 99992);
+        auto tail = Slice<long long>(ls, int(n), 0, &repl);  // вставка в конец
+        assert(tail->GetLength() == n + 2 && tail->GetLast() == 8);
+
+        MutableListSequence<long long> both;
+        both.Concat(&us);
+        assert(both.GetLength() == n && both.Get(12345) == 12345);
+    }
+
+    // --- 6.18 SIMD-ядра: каждый доступный ISA против скалярной версии ---
+    {
+        auto check = [](auto tag, size_t n) {
+            using T = decltype(tag);
+            std::vector<T> v(n);
+            for (size_t i = 0; i < n; ++i) v[i] = static_cast<T>(int((i * 37 + 11) % 101) - (std::is_signed_v<T> ? 50 : 0));
+            if (n > 3) v[n - 2] = static_cast<T>(-3);       // экстремум в хвосте
+            auto gt = [](auto x) { return x > T(20); };
+            auto lin = [](auto x) { return x * T(2) + T(1); };   // для signed char без переполнения
+            auto hit = [](auto x) { return x == T(7); };
+
+            simd::ForceIsa(simd::Isa::Scalar);
+            auto s0 = simd::Sum(v.data(), n);
+            T mn0 = simd::Min(v.data(), n), mx0 = simd::Max(v.data(), n);
+            size_t c0 = simd::CountIf(v.data(), n, gt), f0 = simd::FindFirst(v.data(), n, hit);
+            std::vector<T> m0(n), w0(n);
+            simd::Transform(v.data(), n, m0.data(), lin);
+            size_t k0 = simd::Compact(v.data(), n, w0.data(), gt);
+            w0.resize(k0);
+            assert(c0 == k0);
+
+            for (auto isa : {simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512}) {
+                if (static_cast<int>(isa) > static_cast<int>(simd::DetectIsa())) break;
+                simd::ForceIsa(isa);
+                assert(simd::Sum(v.data(), n) == s0);       // значения целые — порядок сложения не важен
+                assert(simd::Min(v.data(), n) == mn0 && simd::Max(v.data(), n) == mx0);
+                assert(simd::CountIf(v.data(), n, gt) == c0);
+                assert(simd::FindFirst(v.data(), n, hit) == f0);
+                std::vector<T> m(n), w(n);
+                simd::Transform(v.data(), n, m.data(), lin);
+                assert(m == m0);
+                w.resize(simd::Compact(v.data(), n, w.data(), gt));
+                assert(w == w0);
+            }
+            simd::ForceIsa(simd::DetectIsa());
+        };
+        for (size_t n : {1, 15, 64, 1001, 70000}) {
+            check(int(), n); check(double(), n); check(float(), n);
+            check((long long)0, n); check((signed char)0, n); check((unsigned short)0, n);
+        }
+
+        bool threw = false;
+        try { simd::Min((int*)nullptr, 0); } catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+
+        // поверх Sequence: куски разных контейнеров
+        const size_t n = 10000;
+        MutableArraySequence<int> as;
+        MutableListSequence<int, UnrolledLinkedList<int, 48>> us;
+        for (size_t i = 0; i < n; ++i) { as.Append(int(i) - 5000); us.Append(int(i) - 5000); }
+        assert(Sum(as) == -5000LL && Sum(us) == -5000LL);
+        assert(Min(us) == -5000 && Max(us) == 4999 && Max(as) == 4999);
+        assert(CountIfSimd(us, [](auto x) { return x < 0; }) == 5000);
+        assert(FindIndexSimd(us, [](auto x) { return x == 1234; }) == 6234);
+        assert(FindIndexSimd(as, [](auto x) { return x > 99999; }) == n);
+        auto twice = MapSimd(us, [](auto x) { return x * 2; });
+        assert(twice->GetLength() == n && twice->Get(9999) == 9998);
+        auto odd = WhereSimd(us, [](auto x) { return (x & 1) != 0; });
+        assert(odd->GetLength() == n / 2 && odd->GetFirst() == -4999 && odd->GetLast() == 4999);
+        for (auto isa : {simd::Isa::Scalar, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512}) {
+            if (static_cast<int>(isa) > static_cast<int>(simd::DetectIsa())) break;
+            simd::ForceIsa(isa);                            // предикат не маска: дорожки 1/0, а не -1/0
+            assert(CountIfSimd(as, [](auto x) { return x & 1; }) == n / 2);
+            assert(WhereSimd(as, [](auto x) { return x & 3; })->GetLength() == n - n / 4);
+        }
+        simd::ForceIsa(simd::DetectIsa());
+        MutableArraySequence<double> empty;
+        assert(Sum(empty) == 0.0 && WhereSimd(empty, [](auto x) { return x > 0; })->GetLength() == 0);
+    }
+
+    // --- 6.19 ThreadPool и параллельные Map / Reduce / Where / FlatMap ---
+    {
+        ThreadPool pool(4);
+        assert(pool.Size() == 4);
+        const size_t n = 50000;
+        MutableArraySequence<int> as;
+        MutableListSequence<int> ls;
+        for (size_t i = 0; i < n; ++i) { as.Append(int(i)); ls.Append(int(i)); }
+        const Grain small = Grain::Fixed(777);               // много задач, неровный хвост
+
+        for (const Sequence<int>* s : { (const Sequence<int>*)&as, (const Sequence<int>*)&ls }) {
+            auto sq = ParallelMap<long long>(*s, [](int v) { return (long long)v * v; }, pool, small);
+            assert(sq->GetLength() == n && sq->Get(0) == 0 && sq->Get(n - 1) == (long long)(n - 1) * (n - 1));
+            long long sum = ParallelReduce(*s, 0LL, [](long long a, int v) { return a + v; },
+                                           [](long long a, long long b) { return a + b; }, pool, small);
+            assert(sum == (long long)n * (n - 1) / 2);
+            auto odd = ParallelWhere(*s, [](int v) { return v % 3 == 1; }, pool, small);
+            assert(odd->GetLength() == (n + 1) / 3);
+            for (size_t i = 0; i < odd->GetLength(); ++i) assert(odd->Get(i) == int(3 * i + 1));   // порядок сохранён
+            auto fm = ParallelFlatMap<int>(*s, [](int v) {
+                auto r = SeqUPtr<int>(new MutableArraySequence<int>);
+                for (int k = 0; k < v % 3; ++k) r->Append(v);
+                return r;
+            }, pool, small);
+            assert(fm->GetLength() == (n + 1) / 3 + 2 * (n / 3) && fm->Get(0) == 1 && fm->Get(1) == 2 && fm->Get(2) == 2);
+        }
+
+        // результат без конструктора по умолчанию; если f бросил — построенное разрушено
+        {
+            auto tr = ParallelMap<Tracked>(as, [](int v) { return Tracked(v * 2); }, pool, small);
+            assert(tr->GetLength() == n && tr->Get(n - 1).v == int(2 * (n - 1)) && Tracked::alive == int(n));
+            auto kept = ParallelWhere(*tr, [](const Tracked& t) { return t.v % 4 == 0; }, pool, small);
+            assert(kept->GetLength() == (n + 1) / 2 && kept->Get(1).v == 4);
+            bool threw = false;
+            try {
+                ParallelMap<Tracked>(as, [](int v) {
+                    if (v == int(n / 2)) throw std::runtime_error("f");
+                    return Tracked(v);
+                }, pool, small);
+            } catch (const std::runtime_error&) { threw = true; }
+            assert(threw && Tracked::alive == int(n + (n + 1) / 2));
+        }
+        assert(Tracked::alive == 0);
+
+        // некоммутативная, но ассоциативная операция — куски склеиваются по порядку
+        MutableArraySequence<std::string> words;
+        std::string expect;
+        for (int i = 0; i < 3000; ++i) { words.Append(std::to_string(i % 10)); expect += std::to_string(i % 10); }
+        auto cat = [](const std::string& a, const std::string& b) { return a + b; };
+        assert(ParallelReduce(words, std::string(), cat, pool, Grain::Fixed(100)) == expect);
+        MutableArraySequence<int> none;
+        assert(ParallelReduce(none, 5, [](int a, int b) { return a + b; }, pool) == 5);
+        assert(ParallelWhere(none, [](int) { return true; }, pool)->GetLength() == 0);
+
+        // вложенный ParallelFor не блокирует пул; исключение из задачи доходит до вызывающего
+        std::atomic<long long> total{0};
+        pool.ParallelFor(64, size_t(1), [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i)
+                pool.ParallelFor(1000, size_t(100), [&](size_t x, size_t y) { total += (long long)(y - x); });
+        });
+        assert(total == 64000);
+        bool threw = false;
+        try {
+            pool.ParallelFor(100, size_t(10), [](size_t b, size_t) { if (b == 50) throw std::runtime_error("task"); });
+        } catch (const std::runtime_error&) { threw = true; }
+        assert(threw);
+
+        ThreadPool one(1);                                   // без фоновых потоков — всё в вызывающем
+        assert(ParallelReduce(as, 0LL, [](long long a, int v) { return a + v; },
+                              [](long long a, long long b) { return a + b; }, one) == (long long)n * (n - 1) / 2);
+    }
+
+    // --- 6.20 Ленивые конвейеры View(): слияние стадий и ранняя остановка ---
+    {
+        MutableListSequence<int, UnrolledLinkedList<int, 32>> us;
+        for (int i = 0; i < 1000; ++i) us.Append(i);
+        const Sequence<int>& s = us;
+
+        size_t mapped = 0;
+        auto v = s.View().Where([](int x) { return x % 2 == 0; })
+                         .Map([&mapped](int x) { ++mapped; return (long long)x * 10; })
+                         .Take(5);
+        assert(mapped == 0);                                  // стадии ничего не вычисляют
+        assert(v.Reduce(0LL, [](long long a, long long x) { return a + x; }) == 200);
+        assert(mapped == 5);                                  // Take остановил обход
+        auto mat = v.ToSequence();
+        assert(mat->GetLength() == 5 && mat->Get(4) == 80);
+
+        mapped = 0;
+        auto hit = s.View().Map([&mapped](int x) { ++mapped; return x * x; }).TryFirst([](int x) { return x > 50; });
+        assert(hit && *hit == 64 && mapped == 9);
+        assert(!s.View().TryFirst([](int x) { return x < 0; }));
+        assert(s.View().Skip(990).Count() == 10 && s.View().Skip(2000).Count() == 0);
+        assert(s.View().TakeWhile([](int x) { return x < 7; }).Count() == 7);
+        assert(s.View().Take(0).Count() == 0 && s.View().Take(3).Take(10).Count() == 3);
+
+        auto fm = s.View().Take(4).FlatMap([](int x) {
+            auto r = SeqUPtr<int>(new MutableArraySequence<int>);
+            for (int k = 0; k < x; ++k) r->Append(x);
+            return r;
+        });
+        assert(fm.Count() == 6 && fm.Take(2).ToSequence()->GetLast() == 2);   // 1 2 2 3 3 3
+
+        auto small = s.View().Map([](int x) { return std::to_string(x); }).Skip(10).Take(3)
+                      .ToSequence<SmallArraySequence<std::string, 4>>();
+        assert(small->GetLength() == 3 && small->Get(0) == "10" && small->Get(2) == "12");
+
+        std::vector<int> seen;
+        MutableArraySequence<int> empty;
+        empty.View().Where([](int) { return true; }).ForEach([&](int x) { seen.push_back(x); });
+        assert(seen.empty() && !empty.View().TryFirst());
+    }
+
+    // --- 6.21 PersistentVector: версии со структурным разделением ---
+    {
+        // все промежуточные версии остаются валидными; размеры покрывают рост дерева вверх
+        const size_t n = 40000;
+        std::vector<PersistentVector<int>> hist;
+        PersistentVector<int> v;
+        for (size_t i = 0; i < n; ++i) {
+            if (i % 997 == 0 || i == 32 || i == 33 || i == 1056 || i == 1057) hist.push_back(v);
+            v = v.PushBack(int(i));
+        }
+        assert(v.GetSize() == n && v[0] == 0 && v[n - 1] == int(n - 1) && v[33000] == 33000);
+        for (auto& h : hist)
+            for (size_t i = 0; i < h.GetSize(); i += 7) assert(h[i] == int(i));
+
+        // ветвление: две версии дописывают в один общий хвост
+        auto a = v.PushBack(-1), b = v.PushBack(-2);
+        assert(a[n] == -1 && b[n] == -2 && v.GetSize() == n);
+
+        auto s = v.Set(5, 500).Set(n - 1, 900);
+        assert(s[5] == 500 && s[n - 1] == 900 && v[5] == 5 && v[n - 1] == int(n - 1));
+
+        // PopBack через границы листов и уменьшение высоты; сверка со std::vector
+        std::vector<int> ref(n);
+        for (size_t i = 0; i < n; ++i) ref[i] = int(i);
+        auto p = v;
+        while (p.GetSize() > 0) {
+            p = p.PopBack(); ref.pop_back();
+            if (ref.size() % 331 == 0 || ref.size() < 70)
+                for (size_t i = 0; i < ref.size(); i += 13) assert(p[i] == ref[i]);
+        }
+        assert(v[n - 1] == int(n - 1));
+        auto q = v.PopBack().PopBack().PushBack(7);          // дописать после PopBack — хвост копируется
+        assert(q[n - 2] == 7 && v[n - 2] == int(n - 2));
+
+        size_t chunks = 0, seen = 0;
+        ChunkCursor c; const int* cp; size_t cn;
+        while (v.NextChunk(c, cp, cn)) { assert(*cp == int(seen)); seen += cn; ++chunks; }
+        assert(seen == n && chunks == (n + 31) / 32);
+
+        bool threw = false;
+        try { (void)v[n]; } catch (const std::out_of_range&) { threw = true; }
+        assert(threw);
+
+        // без утечек и двойных разрушений
+        Tracked::alive = 0;
+        {
+            PersistentVector<Tracked> t;
+            std::vector<PersistentVector<Tracked>> keep;
+            for (int i = 0; i < 3000; ++i) {
+                t = t.PushBack(Tracked(i));
+                if (i % 100 == 0) keep.push_back(t.Set(i / 2, Tracked(-i)));
+            }
+            for (int i = 0; i < 1500; ++i) t = t.PopBack();
+            assert(t.GetSize() == 1500 && t[1499].v == 1499 && keep.back()[1450].v == -2900);
+        }
+        assert(Tracked::alive == 0);
+
+        // как Sequence
+        PersistentArraySequence<int> ps;
+        SeqUPtr<int> cur = ps.Clone();
+        for (int i = 0; i < 100; ++i) cur = static_cast<const Sequence<int>&>(*cur).Append(i);
+        const Sequence<int>& cs = *cur;
+        assert(cs.GetLength() == 100 && cs.GetLast() == 99 && cs.Reduce(0, [](int x, int y) { return x + y; }) == 4950);
+        auto ins = cs.InsertAt(-5, 40);
+        assert(ins->GetLength() == 101 && ins->Get(40) == -5 && ins->Get(41) == 40 && cs.Get(40) == 40);
+        auto pre = cs.Prepend(-1);
+        assert(pre->GetFirst() == -1 && pre->Get(100) == 99);
+        auto cat = cs.Concat(&cs);
+        assert(cat->GetLength() == 200 && cat->Get(150) == 50);
+        auto sub = cs.GetSubsequence(30, 69);
+        assert(sub->GetLength() == 40 && sub->GetFirst() == 30 && sub->GetLast() == 69);
+        auto head = cs.GetSubsequence(0, 79);
+        assert(head->GetLength() == 80 && head->GetLast() == 79);
+        auto set = static_cast<const PersistentArraySequence<int>&>(cs).Set(3, 33);
+        assert(set->Get(3) == 33 && cs.Get(3) == 3);
+        threw = false;
+        try { cur->Append(1); } catch (const std::logic_error&) { threw = true; }
+        assert(threw);
+    }
+
+    // --- 6.22 PersistentList: общие хвосты за ImmutableListSequence ---
+    {
+        PersistentList<int> a;
+        for (int i = 0; i < 5; ++i) a.Append(i);             // 0 1 2 3 4
+        PersistentList<int> b = a, c = a;                    // O(1), общие узлы
+        b.Append(10);                                        // дописывает за общим хвостом
+        c.Append(20);                                        // слот занят — копирует префикс
+        assert(a.GetLength() == 5 && a.GetLast() == 4);
+        assert(b.GetLast() == 10 && c.GetLast() == 20 && b.Get(5) == 10 && c.Get(5) == 20);
+        b.Prepend(-1); b.InsertAt(7, 3);                     // -1 0 1 7 2 3 4 10
+        assert(b.GetLength() == 8 && b.GetFirst() == -1 && b.Get(3) == 7 && b.Get(4) == 2 && a.Get(2) == 2);
+        std::unique_ptr<PersistentList<int>> mid(a.GetSubList(1, 3));
+        assert(mid->GetLength() == 3 && mid->GetFirst() == 1 && mid->GetLast() == 3);
+        mid->Append(99);                                     // за узлом 3 уже есть 4 — копия
+        assert(mid->Get(3) == 99 && a.Get(4) == 4);
+        int k = 0;
+        for (int v : a) assert(v == k++);
+        assert(k == 5);
+        assert(a.PopFront() == 0 && a.GetFirst() == 1 && b.Get(1) == 0);
+
+        // длинная цепочка рушится без рекурсии; версии без утечек
+        Tracked::alive = 0;
+        {
+            PersistentList<Tracked> big;
+            for (int i = 0; i < 1000000; ++i) big.Prepend(Tracked(i));
+            PersistentList<Tracked> tail(*std::unique_ptr<PersistentList<Tracked>>(big.GetSubList(10, 999999)));
+            big = PersistentList<Tracked>();
+            assert(tail.GetLength() == 999990 && tail.GetFirst().v == 999989);
+            tail.Append(Tracked(-1)); tail.Prepend(Tracked(-2));
+        }
+        assert(Tracked::alive == 0);
+
+        // ImmutableListSequence по умолчанию — на PersistentList
+        const ImmutableListSequence<int> empty;
+        SeqUPtr<int> s = empty.Clone();
+        for (int i = 0; i < 10000; ++i) s = static_cast<const Sequence<int>&>(*s).Prepend(i);
+        const Sequence<int>& cs = *s;
+        assert(cs.GetLength() == 10000 && cs.GetFirst() == 9999 && cs.GetLast() == 0);
+        auto app = cs.Append(-1);
+        auto cat = cs.Concat(&cs);
+        assert(app->GetLast() == -1 && cs.GetLast() == 0 && cat->GetLength() == 20000 && cat->Get(10000) == 9999);
+        auto suf = cs.GetSubsequence(9990, 9999);
+        assert(suf->GetLength() == 10 && suf->GetFirst() == 9 && suf->GetLast() == 0);
+        auto ins = static_cast<const Sequence<int>&>(*suf).InsertAt(100, 5);
+        assert(ins->Get(5) == 100 && ins->Get(6) == 4 && suf->Get(5) == 4);
+        assert(cs.Reduce(0LL, [](long long x, int y) { return x + y; }) == 49995000LL);
+    }
+
+    // --- 6.23 SequenceSlice: срезы без копирования, копия при записи ---
+    {
+        MutableArraySequence<int> a;
+        for (int i = 0; i < 1000; ++i) a.Append(i);
+        auto sub = a.GetSubsequence(100, 199);
+        assert(sub->GetLength() == 100 && sub->GetFirst() == 100 && sub->GetLast() == 199);
+        assert(&sub->Get(0) == &a.Get(100));                 // тот же буфер
+        auto subsub = sub->GetSubsequence(10, 19);
+        assert(&subsub->Get(0) == &a.Get(110));
+
+        a.Append(1000);                                      // родитель копирует буфер, срез не меняется
+        assert(&sub->Get(0) != &a.Get(100) && sub->Get(0) == 100 && a.GetLength() == 1001);
+        auto& sl = static_cast<SequenceSlice<int>&>(*sub);
+        sl.Append(-1);                                       // срез копирует свой диапазон
+        assert(sl.GetLength() == 101 && sl.GetLast() == -1 && subsub->Get(0) == 110);
+        assert(sl.PopFront() == 100 && sl.GetFirst() == 101);
+
+        // копия последовательности делит буфер до первой записи
+        MutableArraySequence<int> b = a;
+        assert(&b.Get(5) == &a.Get(5));
+        b.EraseRange(0, 9);
+        assert(b.GetFirst() == 10 && a.GetFirst() == 0);
+
+        // буфер живёт, пока жив хоть один срез
+        SeqUPtr<std::string> keep;
+        {
+            MutableArraySequence<std::string> w;
+            for (int i = 0; i < 50; ++i) w.Append("s" + std::to_string(i));
+            keep = w.GetSubsequence(40, 49);
+        }
+        assert(keep->GetLength() == 10 && keep->Get(0) == "s40" && keep->GetLast() == "s49");
+
+        // срез immutable-массива — тоже immutable
+        int raw[] = {1, 2, 3, 4, 5};
+        const ImmutableArraySequence<int> im(raw, 5);
+        auto isub = im.GetSubsequence(1, 3);
+        assert(isub->GetLength() == 3 && &isub->Get(0) == &im.Get(1));
+        bool threw = false;
+        try { isub->Append(9); } catch (const std::logic_error&) { threw = true; }
+        assert(threw);
+        auto grown = static_cast<const Sequence<int>&>(*isub).Append(9);
+        assert(grown->GetLength() == 4 && grown->GetLast() == 9 && isub->GetLength() == 3);
+
+        // SliceView / SplitView / Slice
+        auto win = SliceView<int>(a, 500, 20);
+        assert(win->GetLength() == 20 && &win->Get(0) == &a.Get(500));
+        MutableListSequence<int> ls;
+        for (int i = 0; i < 30; ++i) ls.Append(i % 7 == 0 ? -1 : i);
+        auto lwin = SliceView<int>(ls, 3, 4);
+        assert(lwin->GetLength() == 4 && lwin->Get(0) == 3);
+        auto parts = SplitView(ls, [](int v) { return v < 0; });
+        assert(parts->GetLength() == 5 && parts->Get(0).GetLength() == 6 && parts->Get(0).GetFirst() == 1);
+        assert(&parts->Get(1).Get(0) + 7 == &parts->Get(2).Get(0));   // куски одной копии
+        MutableArraySequence<int> arr;
+        for (int i = 0; i < 30; ++i) arr.Append(i % 7 == 0 ? -1 : i);
+        auto aparts = SplitView(arr, [](int v) { return v < 0; });
+        assert(aparts->GetLength() == 5 && &aparts->Get(4).Get(0) == &arr.Get(29));
+        auto rest = Slice<int>(a, 0, 900);                   // срез с головы — остаток непрерывен
+        assert(rest->GetLength() == 101 && &rest->Get(0) == &a.Get(900));
+        auto mid = Slice<int>(a, 10, 5);                     // дырка в середине — копия
+        assert(mid->GetLength() == 996 && mid->Get(10) == 15);
+
+        // LinkedList::GetSubList — один проход
+        LinkedList<int> ll;
+        for (int i = 0; i < 100000; ++i) ll.Append(i);
+        std::unique_ptr<LinkedList<int>> part(ll.GetSubList(50000, 99999));
+        assert(part->GetLength() == 50000 && part->GetFirst() == 50000 && part->GetLast() == 99999);
+    }
+
+    // --- 6.24 RopeSequence: сверка со std::vector на случайных правках ---
+    {
+        auto same = [](const Sequence<int>& s, const std::vector<int>& ref) {
+            if (s.GetLength() != ref.size()) return false;
+            size_t i = 0; bool ok = true;
+            s.ForEach([&](int v) { ok = ok && v == ref[i++]; });
+            return ok;
+        };
+        std::vector<int> ref;
+        RopeSequence<int> r;
+        std::srand(17);
+        for (int step = 0; step < 20000; ++step) {
+            int op = std::rand() % 10;
+            size_t n = ref.size();
+            if (op < 4 || n < 10) {
+                size_t at = std::rand() % (n + 1);
+                r.InsertAt(step, at); ref.insert(ref.begin() + at, step);
+            } else if (op < 6) {
+                size_t at = std::rand() % n;
+                assert(r.RemoveAt(at) == ref[at]); ref.erase(ref.begin() + at);
+            } else if (op == 6) {
+                size_t l = std::rand() % n, rr = l + std::rand() % std::min<size_t>(n - l, 50);
+                r.EraseRange(l, rr); ref.erase(ref.begin() + l, ref.begin() + rr + 1);
+            } else if (op == 7) {
+                size_t at = std::rand() % n, k = std::rand() % (n - at + 1);
+                r.Splice(at, k, &r);                         // вставка самой себя — общие узлы
+                std::vector<int> copy = ref;
+                ref.erase(ref.begin() + at, ref.begin() + at + k);
+                ref.insert(ref.begin() + at, copy.begin(), copy.end());
+                if (ref.size() > 5000) {                     // не даём разрастись
+                    auto tail = r.SplitAt(2000);
+                    assert(tail->GetLength() == ref.size() - 2000 && tail->Get(0) == ref[2000]);
+                    ref.resize(2000);
+                }
+            } else {
+                size_t i = std::rand() % n;
+                assert(r.Get(i) == ref[i]);
+            }
+            if (step % 500 == 0) assert(same(r, ref));
+        }
+        assert(same(r, ref));
+
+        // высота логарифмическая, Concat/GetSubsequence не копируют элементы
+        std::vector<int> big(1000000);
+        for (size_t i = 0; i < big.size(); ++i) big[i] = int(i);
+        RopeSequence<int> a(big.data(), big.size());
+        assert(a.GetRope().Height() <= 20);
+        for (int i = 0; i < 10; ++i) a.Concat(&a);           // 1024 * 1M элементов
+        assert(a.GetLength() == 1024000000u && a.Get(1023999999u) == 999999 && a.Get(5000001) == 1);
+        assert(a.GetRope().Height() <= 40);
+        auto sub = a.GetSubsequence(999990, 1000009);
+        assert(sub->GetLength() == 20 && sub->Get(9) == 999999 && sub->Get(10) == 0);
+        int patch[] = {-1, -2, -3};
+        RopeSequence<int> p(patch, 3);
+        auto sl = Slice<int>(a, 5, 1000000000, &p);          // O(log n) на верёвке
+        assert(sl->GetLength() == 24000003u && sl->Get(4) == 4 && sl->Get(5) == -1 && sl->Get(8) == 5);
+        const Sequence<int>& ca = a;
+        auto ins = ca.InsertAt(7, 3);
+        assert(ins->Get(3) == 7 && ca.Get(3) == 3 && ins->GetLength() == a.GetLength() + 1);
+
+        MutableListSequence<std::string> words;
+        words.Append("b"); words.Append("c");
+        RopeSequence<std::string> rs;
+        rs.Append("a"); rs.Concat(&words); rs.Prepend("_");
+        assert(rs.GetLength() == 4 && rs.Get(0) == "_" && rs.Get(3) == "c" && rs.PopBack() == "c");
+        {
+            RopeSequence<Tracked> t;                          // T без конструктора по умолчанию
+            for (int i = 0; i < 1000; ++i) t.InsertAt(Tracked(i), size_t(i) / 2);
+            auto tail = t.SplitAt(300);
+            t.Concat(tail.get()); t.EraseRange(10, 700);
+            assert(t.GetLength() == 309);
+        }
+        assert(Tracked::alive == 0);
+    }
+
+    // --- 6.25 Перенос и Emplace: ни одной копии на пути вставки ---
+    {
+        using CM = CopyMove;
+        MutableArraySequence<CM> arr;
+        CM::Reset();
+        for (int i = 0; i < 100; ++i) arr.Append(CM(std::to_string(i)));
+        arr.InsertAt(CM("mid"), 50);
+        arr.Prepend(CM("front"));
+        arr.EmplaceBack(3, 'x');
+        arr.EmplaceAt(1, std::string("second"));
+        assert(CM::copies == 0 && arr.GetLength() == 104);
+        assert(arr.Get(0).s == "front" && arr.Get(1).s == "second" && arr.Get(52).s == "mid" && arr.GetLast().s == "xxx");
+        assert(&arr.GetFirst() == &arr.Get(0));            // ссылка, а не копия
+
+        Sequence<CM>& base = arr;                          // через виртуальный интерфейс — тоже move
+        CM::Reset();
+        base.Append(CM("v")); base.EmplaceFront("w"); base.InsertAt(CM("u"), 3);
+        assert(CM::copies == 0 && base.GetFirst().s == "w" && base.Get(3).s == "u");
+        CM keep("lvalue");
+        base.Append(keep);
+        assert(CM::copies == 1 && keep.s == "lvalue");
+
+        MutableListSequence<CM> lst;
+        CM::Reset();
+        lst.EmplaceBack(2, 'a'); lst.EmplaceFront(1, 'b'); lst.EmplaceAt(1, "c");
+        lst.Append(CM("d")); lst.InsertAt(CM("e"), 2);
+        assert(CM::copies == 0 && CM::moves == 2 && lst.GetLength() == 5);
+        assert(lst.GetFirst().s == "b" && lst.Get(1).s == "c" && lst.Get(2).s == "e" && lst.GetLast().s == "d");
+
+        MutableListSequence<CM, UnrolledLinkedList<CM, 4>> ul;
+        CircularArraySequence<CM> cs;
+        SmallArraySequence<CM, 4> sm;
+        CM::Reset();
+        for (int i = 0; i < 10; ++i) {
+            ul.Append(CM("u")); ul.EmplaceAt(0, "v");
+            cs.Append(CM("c")); cs.Prepend(CM("p")); cs.InsertAt(CM("i"), 1);
+            sm.Append(CM("s")); sm.Prepend(CM("t"));
+        }
+        assert(CM::copies == 0 && ul.GetLength() == 20 && cs.GetLength() == 30 && sm.GetLength() == 20);
+        assert(ul.GetFirst().s == "v" && cs.Get(1).s == "i" && sm.GetFirst().s == "t");
+
+        Stack<CM> st; Queue<CM> q; Deque<CM> dq; PriorityQueue<CM> pq;
+        CM::Reset();
+        st.Push(CM("a")); st.Emplace("b");
+        q.Enqueue(CM("a")); q.Emplace("b");
+        dq.PushBack(CM("b")); dq.PushFront(CM("a")); dq.EmplaceBack("c"); dq.EmplaceFront("z");
+        pq.Push(CM("m")); pq.Emplace("x"); pq.Push(CM("a"));
+        assert(CM::copies == 0);
+        assert(st.Top().s == "b" && q.Front().s == "a" && dq.Front().s == "z" && dq.Back().s == "c" && pq.Top().s == "x");
+        assert(st.Pop().s == "b" && q.Dequeue().s == "a" && pq.Pop().s == "x" && pq.Top().s == "m");
+        assert(CM::copies == 0);
+
+        DynamicArray<CM> da;
+        CM::Reset();
+        for (int i = 0; i < 20; ++i) da.EmplaceBack(size_t(i), 'q');
+        da.Emplace(5, "five");
+        assert(CM::copies == 0 && da[5].s == "five" && da[6].s == "qqqqq" && da.GetSize() == 21);
+        CM& ref = da.EmplaceBack("tail");
+        assert(&ref == &da[21]);
+        da.PushBack(da[0]);                                // аргумент внутри самого массива
+        assert(da[22].s.empty() && da[0].s.empty());
+        for (int i = 0; i < 40; ++i) da.PushBack(da[6]);   // и при переездах буфера
+        assert(da.GetSize() == 63 && da[62].s == "qqqqq");
+
+        // move-only элементы: классический Split собирает куски в SeqUPtr
+        MutableArraySequence<int> src;
+        for (int v : {1, 2, 0, 3, 0, 0, 4, 5, 6}) src.Append(v);
+        auto parts = Split(src, [](int v) { return v == 0; });
+        assert(parts->GetLength() == 3 && parts->Get(0)->GetLength() == 2 && parts->Get(2)->GetLast() == 6);
+        auto first = parts->PopFront();
+        assert(first->Get(1) == 2 && parts->GetFirst()->GetFirst() == 3);
+
+        MutableArraySequence<std::unique_ptr<int>> up;
+        up.Append(std::make_unique<int>(1)); up.EmplaceBack(new int(3)); up.InsertAt(std::make_unique<int>(2), 1);
+        assert(*up.Get(0) == 1 && *up.Get(1) == 2 && *up.GetLast() == 3);
+        bool threw = false;
+        try { up.Append(static_cast<const std::unique_ptr<int>&>(up.Get(0))); } catch (const std::logic_error&) { threw = true; }
+        assert(threw && up.GetLength() == 3);
+        auto sub = up.GetSubsequence(1, 2);                // срез делит буфер — копировать нельзя
+        threw = false;
+        try { sub->PopFront(); } catch (const std::logic_error&) { threw = true; }
+        assert(threw && *up.Get(1) == 2);
+        sub.reset();
+        assert(*up.PopFront() == 1 && *up.GetFirst() == 2);
+    }
+
+    // --- 6.26 InsertRange / AppendRange / PrependRange, Concat и Slice пачками ---
+    {
+        DynamicArray<int> a;
+        for (int i = 0; i < 10; ++i) a.PushBack(i);
+        std::vector<int> big(1000);
+        for (int i = 0; i < 1000; ++i) big[i] = 100 + i;
+        size_t cap0 = a.GetCapacity();
+        a.InsertRange(5, big.data(), big.data() + big.size());     // один переезд сразу под итог
+        assert(a.GetSize() == 1010 && a.GetCapacity() == std::max<size_t>(1010, 2 * cap0));
+        assert(a[4] == 4 && a[5] == 100 && a[1004] == 1099 && a[1005] == 5 && a[1009] == 9);
+        a.Reserve(2000);
+        int* before = a.begin();
+        int three[] = {-1, -2, -3};
+        a.InsertRange(2, three, three + 3);
+        a.PrependRange(three, three + 1); a.AppendRange(three + 1, three + 3);
+        assert(a.begin() == before && a.GetSize() == 1016 && a[0] == -1 && a[3] == -1 && a[5] == -3 && a[1015] == -3);
+
+        // источник внутри самого массива, в т.ч. в сдвигаемом хвосте, и произвольные итераторы
+        std::srand(19);
+        DynamicArray<std::string> ds; std::vector<std::string> ref;
+        for (int step = 0; step < 300; ++step) {
+            size_t at = std::rand() % (ref.size() + 1);
+            if (step % 3 == 0 && !ref.empty()) {
+                size_t l = std::rand() % ref.size(), r = l + std::rand() % (ref.size() - l + 1);
+                std::vector<std::string> piece(ref.begin() + l, ref.begin() + r);
+                ds.InsertRange(at, ds.begin() + l, ds.begin() + r);
+                ref.insert(ref.begin() + at, piece.begin(), piece.end());
+            } else {
+                std::vector<std::string> piece(std::rand() % 5, std::to_string(step));
+                auto copy = piece;
+                ds.InsertRange(at, std::make_move_iterator(piece.begin()), std::make_move_iterator(piece.end()));
+                ref.insert(ref.begin() + at, copy.begin(), copy.end());
+            }
+            if (ref.size() > 2000) { ds.Erase(500, ds.GetSize() - 1); ref.resize(500); }
+        }
+        assert(ds.GetSize() == ref.size() && std::equal(ref.begin(), ref.end(), ds.begin()));
+        DynamicArray<int> self;
+        for (int i = 0; i < 8; ++i) self.PushBack(i);
+        self.Reserve(64);
+        self.InsertRange(2, self.begin() + 1, self.begin() + 6);  // хвост и источник пересекаются
+        int want[] = {0, 1, 1, 2, 3, 4, 5, 2, 3, 4, 5, 6, 7};
+        assert(self.GetSize() == 13 && std::equal(want, want + 13, self.begin()));
+        {
+            std::list<Tracked> src;
+            for (int i = 0; i < 7; ++i) src.emplace_back(i);
+            DynamicArray<Tracked> dt;
+            dt.PushBack(Tracked(-1)); dt.PushBack(Tracked(-2));
+            dt.InsertRange(1, src.begin(), src.end());
+            dt.Reserve(40);
+            dt.InsertRange(3, src.begin(), src.end());
+            assert(dt.GetSize() == 16 && dt[1].v == 0 && dt[3].v == 0 && dt[10].v == 2 && dt[15].v == -2);
+            assert(Tracked::alive == 23);
+        }
+        assert(Tracked::alive == 0);
+
+        // последовательности
+        MutableArraySequence<int> ms(three, 3);
+        ms.AppendRange(big.begin(), big.begin() + 4);
+        ms.PrependRange(big.end() - 2, big.end());
+        ms.InsertRange(2, three, three + 2);
+        assert(ms.GetLength() == 11 && ms.Get(0) == 1098 && ms.Get(2) == -1 && ms.Get(4) == -1 && ms.GetLast() == 103);
+        ms.Concat(&ms);                                        // сам с собой — ровно удвоение
+        assert(ms.GetLength() == 22 && ms.Get(11) == 1098 && ms.GetLast() == 103);
+        MutableListSequence<int> lsrc(three, 3);
+        ms.Concat(&lsrc);
+        assert(ms.GetLength() == 25 && ms.GetLast() == -3);
+        ImmutableArraySequence<int> is(three, 3);
+        auto is2 = is.InsertRange(1, big.begin(), big.begin() + 2);
+        auto is3 = static_cast<const Sequence<int>&>(is).Concat(&lsrc);
+        assert(is.GetLength() == 3 && is2->GetLength() == 5 && is2->Get(1) == 100 && is2->Get(3) == -2);
+        assert(is3->GetLength() == 6 && is3->Get(3) == -1 && is.AppendRange(three, three + 3)->GetLast() == -3);
+        auto sl = SliceView<int>(ms, 3, 5);
+        sl->Concat(&lsrc);
+        assert(sl->GetLength() == 8 && sl->GetLast() == -3 && ms.GetLength() == 25);
+
+        // Slice с заменой сверяется с наивной сборкой на разных источниках
+        std::vector<int> base(300);
+        for (int i = 0; i < 300; ++i) base[i] = i;
+        MutableArraySequence<int> as(base.data(), base.size());
+        MutableListSequence<int> ls(base.data(), base.size());
+        MutableListSequence<int, UnrolledLinkedList<int, 16>> us(base.data(), base.size());
+        MutableArraySequence<int> rp(three, 3);
+        for (int t = 0; t < 200; ++t) {
+            int from = std::rand() % 301;
+            size_t cnt = std::rand() % (301 - from);
+            const Sequence<int>* repl = t % 2 ? &rp : nullptr;
+            std::vector<int> exp(base.begin(), base.begin() + from);
+            if (repl) exp.insert(exp.end(), three, three + 3);
+            exp.insert(exp.end(), base.begin() + from + cnt, base.end());
+            for (const Sequence<int>* src : {static_cast<const Sequence<int>*>(&as), static_cast<const Sequence<int>*>(&ls),
+                                             static_cast<const Sequence<int>*>(&us)}) {
+                auto r = Slice<int>(*src, from, cnt, repl);
+                assert(r->GetLength() == exp.size() && std::equal(exp.begin(), exp.end(), r->begin()));
+            }
+        }
+    }
+
+    // --- 6.27 Политики проверки границ: Checked / Assert / Unchecked ---
+    {
+        DynamicArray<int> a;
+        for (int i = 0; i < 5; ++i) a.PushBack(i * 10);
+        bool thrown = false;
+        try { a[5]; } catch (const std::out_of_range& e) {
+            thrown = std::string(e.what()) == "IndexOutOfRange: index=5 size=5";
+        }
+        assert(thrown);
+        assert(a.GetUnchecked(3) == 30 && a.data() == a.begin() && a.data()[4] == 40);
+
+        DynamicArray<int, GrowDouble, UncheckedBounds> u;
+        DynamicArray<int, GrowDouble, AssertBounds>    d;
+        for (int i = 0; i < 100; ++i) { u.PushBack(i); d.PushBack(i); }
+        long long su = 0, sd = 0;
+        for (size_t i = 0; i < 100; ++i) { su += u[i]; sd += d[i]; }
+        assert(su == 4950 && sd == 4950);
+        thrown = false;
+        try { u.RemoveAt(100); } catch (const std::out_of_range&) { thrown = true; }   // мутации проверяются всегда
+        assert(thrown);
+
+        LinkedList<int> l;
+        for (int i = 0; i < 5; ++i) l.Append(i);
+        thrown = false;
+        try { l.Get(7); } catch (const std::out_of_range& e) {
+            thrown = std::string(e.what()) == "IndexOutOfRange: index=7 length=5";
+        }
+        assert(thrown && l.GetUnchecked(2) == 2);
+        LinkedList<int, HeapNodeAlloc, UncheckedBounds> lu;
+        for (int i = 0; i < 5; ++i) lu.Append(i);
+        assert(lu.Get(4) == 4 && lu.GetUnchecked(0) == 0);
+
+        int src[] = {1, 2, 3, 4};
+        MutableArraySequence<int> ms(src, 4);
+        thrown = false;
+        try { ms.Get(4); } catch (const std::out_of_range&) { thrown = true; }
+        assert(thrown && ms.GetUnchecked(3) == 4 && ms.data()[0] == 1);
+        MutableArraySequence<int, UncheckedBounds> mu(src, 4);
+        mu.Append(5);
+        assert(mu.Get(4) == 5 && mu.Reduce(0, [](int x, int y) { return x + y; }) == 15);
+        ImmutableArraySequence<int, AssertBounds> im(src, 4);
+        assert(im.Get(3) == 4 && im.data()[1] == 2);
+        // разделение буфера работает при любой политике
+        auto sub = Slice<int>(mu, 1, 2);
+        assert(sub->GetLength() == 3 && sub->Get(0) == 1 && sub->Get(1) == 4);
+        MutableListSequence<int, LinkedList<int, HeapNodeAlloc, UncheckedBounds>> lsu(src, 4);
+        assert(lsu.Get(2) == 3);
+    }
+
+    // --- 6.28 Sort / StableSort / PartialSort / NthElement, параллельная сортировка ---
+    {
+        std::srand(2028);
+        const size_t n = 20000;
+        std::vector<std::vector<int>> inputs(6, std::vector<int>(n));
+        for (size_t i = 0; i < n; ++i) {
+            inputs[0][i] = std::rand();
+            inputs[1][i] = int(i);                                  // уже отсортирован
+            inputs[2][i] = int(n - i);                              // обратный порядок
+            inputs[3][i] = 7;                                       // все равны
+            inputs[4][i] = int(i < n / 2 ? i : n - i);              // «органная труба»
+            inputs[5][i] = std::rand() % 4;                         // мало разных ключей
+        }
+        for (auto& in : inputs) {
+            std::vector<int> exp = in;
+            std::sort(exp.begin(), exp.end());
+            DynamicArray<int> a;
+            a.AppendRange(in.begin(), in.end());
+            Sort(a);
+            assert(std::equal(exp.begin(), exp.end(), a.begin()));
+
+            SeqUPtr<int> seq(new MutableArraySequence<int>(in.data(), n));
+            Sort(*seq, std::greater<>());
+            assert(std::equal(exp.rbegin(), exp.rend(), seq->begin()));
+
+            const size_t k = 137;
+            MutableArraySequence<int> ps(in.data(), n);
+            PartialSort(ps, k);
+            assert(std::equal(exp.begin(), exp.begin() + k, ps.begin()));
+            MutableArraySequence<int> ns(in.data(), n);
+            NthElement(ns, n / 3);
+            const int* q = ns.begin();
+            assert(q[n / 3] == exp[n / 3]);
+            assert(std::all_of(q, q + n / 3, [&](int v) { return v <= exp[n / 3]; }));
+            assert(std::all_of(q + n / 3, q + n, [&](int v) { return v >= exp[n / 3]; }));
+        }
+        // копия делит буфер: сортируется только своя
+        int raw[] = {5, 3, 9, 1, 7};
+        MutableArraySequence<int> orig(raw, 5);
+        MutableArraySequence<int> cp(orig);
+        Sort(cp);
+        assert(cp.Get(0) == 1 && cp.Get(4) == 9 && orig.Get(0) == 5 && orig.Get(4) == 7);
+        auto sub = orig.GetSubsequence(1, 3);                       // срез {3, 9, 1}
+        Sort(*sub);
+        assert(sub->Get(0) == 1 && sub->Get(2) == 9 && orig.Get(1) == 3);
+        ImmutableArraySequence<int> im(raw, 5);
+        bool thrown = false;
+        try { Sort(im); } catch (const std::logic_error&) { thrown = true; }
+        assert(thrown && im.Get(0) == 5);
+        thrown = false;
+        try { NthElement(orig, 5); } catch (const std::out_of_range&) { thrown = true; }
+        assert(thrown);
+
+        // устойчивость: равные ключи сохраняют исходный порядок
+        using KV = std::pair<int, int>;
+        auto byKey = [](const KV& x, const KV& y) { return x.first < y.first; };
+        std::vector<KV> kv(n);
+        for (size_t i = 0; i < n; ++i) kv[i] = { std::rand() % 50, int(i) };
+        std::vector<KV> kexp = kv;
+        std::stable_sort(kexp.begin(), kexp.end(), byKey);
+        MutableArraySequence<KV> ks(kv.data(), n);
+        StableSort(ks, byKey);
+        assert(std::equal(kexp.begin(), kexp.end(), ks.begin()));
+
+        // LinkedList: узлы перецепляются, адреса значений не меняются
+        LinkedList<KV> kl(kv.data(), n);
+        std::vector<const KV*> addr(n);
+        for (const KV& v : kl) addr[v.second] = &v;
+        kl.Sort(byKey);
+        size_t i = 0;
+        for (const KV& v : kl) { assert(v == kexp[i] && &v == addr[v.second]); ++i; }
+        assert(i == n && kl.GetLast() == kexp.back());
+        kl.Append({ -1, -1 });                                      // хвост после перецепки верный
+        assert(kl.GetLast().first == -1 && kl.GetLength() == n + 1);
+
+        MutableListSequence<KV> ls(kv.data(), n);
+        StableSort(ls, byKey);
+        assert(std::equal(kexp.begin(), kexp.end(), ls.begin()));
+        MutableListSequence<KV, UnrolledLinkedList<KV, 16>> us(kv.data(), n);
+        Sort(us, byKey);
+        assert(std::equal(kexp.begin(), kexp.end(), us.begin()));
+        NthElement(us, 10, byKey);
+        assert(us.Get(10) == kexp[10]);
+        // прочие последовательности — через временный массив
+        RopeSequence<KV> rs(kv.data(), n);
+        StableSort(static_cast<Sequence<KV>&>(rs), byKey);
+        assert(rs.GetLength() == n && std::equal(kexp.begin(), kexp.end(), rs.begin()));
+
+        // параллельная: чётное и нечётное число кусков, слияние делится на много задач
+        for (size_t threads : {4, 3}) {
+            ThreadPool pool(threads);
+            MutableArraySequence<int> big(inputs[0].data(), n);
+            ParallelSort(big, std::less<>(), pool, Grain::Fixed(1000));
+            std::vector<int> exp = inputs[0];
+            std::sort(exp.begin(), exp.end());
+            assert(std::equal(exp.begin(), exp.end(), big.begin()));
+            MutableArraySequence<KV> st(kv.data(), n);
+            ParallelStableSort(st, byKey, pool, Grain::Fixed(1000));
+            assert(std::equal(kexp.begin(), kexp.end(), st.begin()));
+            std::vector<std::string> words(5000);
+            for (auto& w : words) w = std::to_string(std::rand()) + std::string(20, 'x');
+            DynamicArray<std::string> ws;
+            ws.AppendRange(words.begin(), words.end());
+            ParallelSort(ws, std::less<>(), pool, Grain::Fixed(500));
+            std::sort(words.begin(), words.end());
+            assert(std::equal(words.begin(), words.end(), ws.begin()));
+        }
+
+        // записи с ключом PersonID
+        std::vector<Person> people;
+        for (int k = 0; k < 300; ++k)
+            people.emplace_back(PersonID{ std::rand() % 10, std::rand() % 1000 }, "Ivan", "I", "Ivanov", std::time_t(k));
+        MutableArraySequence<Person> pseq(people.data(), people.size());
+        auto byId = [](const Person& x, const Person& y) {
+            PersonID a = x.GetID(), b = y.GetID();
+            return a.series != b.series ? a.series < b.series : a.number < b.number;
+        };
+        StableSort(pseq, byId);
+        std::stable_sort(people.begin(), people.end(), byId);
+        for (size_t k = 0; k < people.size(); ++k) assert(pseq.Get(k).GetBirthDate() == people[k].GetBirthDate());
+    }
+
+    // --- 6.29 RadixSort (LSD) и RadixSortMsd: знаковые, вещественные и составные ключи ---
+    {
+        std::srand(2029);
+        const size_t n = 30000;
+        std::vector<int> iv(n);
+        for (auto& v : iv)                                   // ключ собирается в беззнаковом: << 16 у int переполняется
+            v = int((uint32_t(std::rand()) << 16) ^ uint32_t(std::rand()) ^ (std::rand() % 2 ? 0x80000000u : 0u));
+        iv[0] = std::numeric_limits<int>::min(); iv[1] = std::numeric_limits<int>::max(); iv[2] = -1; iv[3] = 0;
+        std::vector<int> iexp = iv;
+        std::sort(iexp.begin(), iexp.end());
+        for (unsigned bits : {8u, 11u, 16u}) {
+            RadixOptions opt;
+            opt.DigitBits = bits;
+            DynamicArray<int> a;
+            a.AppendRange(iv.begin(), iv.end());
+            RadixSort(a, radix::Identity(), opt);
+            assert(std::equal(iexp.begin(), iexp.end(), a.begin()));
+            MutableArraySequence<int> m(iv.data(), n);
+            RadixSortMsd(m, radix::Identity(), opt);
+            assert(std::equal(iexp.begin(), iexp.end(), m.begin()));
+        }
+
+        std::vector<double> dv(n);
+        for (auto& v : dv) v = (std::rand() - RAND_MAX / 2) * 1e-3 * std::pow(10.0, std::rand() % 20 - 10);
+        dv[0] = -std::numeric_limits<double>::infinity(); dv[1] = std::numeric_limits<double>::infinity();
+        std::vector<double> dexp = dv;
+        std::sort(dexp.begin(), dexp.end());
+        MutableArraySequence<double> ds(dv.data(), n);
+        RadixSort(ds);
+        assert(std::equal(dexp.begin(), dexp.end(), ds.begin()));
+        std::vector<float> fv(dv.begin(), dv.end());
+        std::vector<float> fexp = fv;
+        std::sort(fexp.begin(), fexp.end());
+        DynamicArray<float> fa;
+        fa.AppendRange(fv.begin(), fv.end());
+        RadixSortMsd(fa);
+        assert(std::equal(fexp.begin(), fexp.end(), fa.begin()));
+        float zeros[] = {0.0f, -0.0f, 1.0f, -1.0f};
+        DynamicArray<float> za;
+        za.AppendRange(zeros, zeros + 4);
+        RadixSort(za);
+        assert(za[0] == -1.0f && std::signbit(za[1]) && !std::signbit(za[2]) && za[3] == 1.0f);
+
+        // составной ключ PersonID: LSD устойчива — как std::stable_sort по тому же ключу
+        struct Rec { PersonID id; int order; };
+        std::vector<Rec> rv(n);
+        for (size_t i = 0; i < n; ++i) rv[i] = { { std::rand() % 5 - 2, std::rand() % 100 }, int(i) };
+        auto idKey = [](const Rec& r) { return std::make_pair(r.id.series, r.id.number); };
+        std::vector<Rec> rexp = rv;
+        std::stable_sort(rexp.begin(), rexp.end(), [&](const Rec& x, const Rec& y) { return idKey(x) < idKey(y); });
+        auto sameOrder = [&](const Rec* p) {
+            for (size_t i = 0; i < n; ++i) if (p[i].order != rexp[i].order) return false;
+            return true;
+        };
+        MutableArraySequence<Rec> rs(rv.data(), n);
+        RadixSort(rs, idKey);
+        assert(sameOrder(rs.begin()));
+        MutableArraySequence<Rec> rm(rv.data(), n);
+        RadixSortMsd(rm, idKey, RadixOptions{ 11 });
+        for (size_t i = 0; i < n; ++i) assert(idKey(rm.Get(i)) == idKey(rexp[i]));
+        // три поля разных типов, старшее — первое
+        auto triKey = [](const Rec& r) { return std::make_tuple(std::uint8_t(r.id.number % 3), -double(r.id.number), std::int64_t(r.id.series)); };
+        MutableArraySequence<Rec> rt(rv.data(), n);
+        RadixSort(rt, triKey, RadixOptions{ 16 });
+        std::vector<Rec> texp = rv;
+        std::stable_sort(texp.begin(), texp.end(), [&](const Rec& x, const Rec& y) { return triKey(x) < triKey(y); });
+        for (size_t i = 0; i < n; ++i) assert(rt.Get(i).order == texp[i].order);
+
+        // проходы с одинаковым разрядом пропускаются: ключи < 256 — гистограмма + один проход
+        std::vector<unsigned> small(n);
+        for (auto& v : small) v = unsigned(std::rand() % 256);
+        size_t calls = 0;
+        DynamicArray<unsigned> sa;
+        sa.AppendRange(small.begin(), small.end());
+        RadixSort(sa, [&calls](unsigned v) { ++calls; return v; });
+        assert(calls == 2 * n && std::is_sorted(sa.begin(), sa.end()));
+
+        // параллельная гистограмма
+        ThreadPool pool(4);
+        RadixOptions popt;
+        popt.Pool = &pool;
+        popt.Chunk = Grain::Fixed(1000);
+        MutableArraySequence<Rec> rp(rv.data(), n);
+        RadixSort(rp, idKey, popt);
+        assert(sameOrder(rp.begin()));
+
+        // прочие последовательности — через временный массив
+        MutableListSequence<int> ls(iv.data(), n);
+        RadixSort(static_cast<Sequence<int>&>(ls));
+        assert(std::equal(iexp.begin(), iexp.end(), ls.begin()));
+        ImmutableArraySequence<int> im(iv.data(), 10);
+        bool thrown = false;
+        try { RadixSort(im); } catch (const std::logic_error&) { thrown = true; }
+        assert(thrown);
+        thrown = false;
+        try { RadixSort(sa, radix::Identity(), RadixOptions{ 0 }); } catch (const std::invalid_argument&) { thrown = true; }
+        assert(thrown);
+    }
+
+    // --- 6.30 Счётчики контейнеров (Stats.hpp): с -DSEQ_STATS считают, без него — пустые ---
+    {
+        stats::Reset();
+        DynamicArray<int> a;
+        a.Reserve(10);
+        for (int i = 0; i < 100; ++i) a.PushBack(i);
+        a.RemoveAt(0);
+        DynamicArray<int> acopy = a;
+        LinkedList<int> l;
+        for (int i = 0; i < 10; ++i) l.Append(i);
+        assert(l.Get(5) == 5);
+        l.PopFront();
+        int raw[] = {1, 2, 3, 4, 5};
+        MutableArraySequence<int> m(raw, 5);
+        auto sub = m.GetSubsequence(0, 2);
+        m.Append(6);                                   // буфер общий со срезом — копия
+        m.Append(7);                                   // уже свой — без копии
+        ImmutableArraySequence<int> im(raw, 5);
+        auto im2 = static_cast<const Sequence<int>&>(im).Append(6);
+        MutableListSequence<int> ml(raw, 5);
+        auto mlSub = ml.GetSubsequence(1, 3);
+        auto ml2 = static_cast<const Sequence<int>&>(ml).Append(6);
+        ImmutableListSequence<int, LinkedList<int>> il(raw, 5);
+        auto il2 = static_cast<const Sequence<int>&>(il).Append(6);
+        ImmutableListSequence<int> pl(raw, 5);
+        auto pl2 = static_cast<const Sequence<int>&>(pl).Append(6);
+        Queue<int> q;
+        for (int i = 0; i < 10; ++i) q.Enqueue(i);
+        while (q.Size()) q.Dequeue();
+        Stack<int> st;
+        st.Push(1); st.Push(2); st.Pop();
+
+        using A = stats::ArrayKind; using L = stats::ListKind;
+        using S = stats::SequenceKind; using Ad = stats::AdapterKind;
+        if constexpr (stats::kEnabled) {
+            assert(a.Stats()[A::Reserves] == 1 && a.Stats()[A::Regrowths] > 0);
+            assert(a.Stats()[A::PeakCapacity] >= 100);
+            assert(a.Stats()[A::BytesMoved] >= 99 * sizeof(int));   // сдвиг после RemoveAt(0)
+            assert(acopy.Stats()[A::Reserves] == 0);                // у копии свой счёт
+            assert(l.Stats()[L::NodesAllocated] == 10 && l.Stats()[L::NodesFreed] == 1);
+            assert(l.Stats()[L::PointerHops] == 5);
+            assert(m.Stats()[S::FullCopies] == 1 && m.Stats()[S::BytesCopied] == 5 * sizeof(int));
+            assert(im.Stats()[S::FullCopies] == 1);
+            assert(ml.Stats()[S::FullCopies] == 2);
+            assert(il.Stats()[S::FullCopies] == 1 && pl.Stats()[S::FullCopies] == 0);
+            assert(q.Stats()[Ad::Pushes] == 10 && q.Stats()[Ad::Pops] == 10 && q.Stats()[Ad::RebuildingPops] == 0);
+            assert(st.Stats()[Ad::Pops] == 1 && st.Stats()[Ad::RebuildingPops] == 0);
+            assert(stats::Global<A>()[A::Reserves] >= 1 && stats::Global<L>()[L::NodesAllocated] >= 10);
+            assert(stats::Global<Ad>()[Ad::Pushes] == 12);
+            assert(stats::DumpJson().find("\"Adapter\": {\"pushes\": 12") != std::string::npos);
+        } else {
+            assert(sizeof(DynamicArray<int>) == 2 * sizeof(size_t) + sizeof(int*) + sizeof(std::unique_ptr<mapped::File>));   // пустая база — ни байта
+            assert(sizeof(Stack<int>) == sizeof(std::unique_ptr<Sequence<int>>));
+            assert(a.Stats()[A::Reserves] == 0 && q.Stats()[Ad::Pushes] == 0);
+            assert(stats::DumpJson().find("\"enabled\": false") != std::string::npos);
+        }
+        stats::Reset();
+        assert(stats::Global<A>()[A::Reserves] == 0);
+    }
+
+    // --- 6.31 DynamicArray в файле (mmap): рост, Checkpoint, повторное открытие, ReadOnly ---
+    {
+        const std::string path = "/tmp/laba3_mapped_" + std::to_string(::getpid()) + ".bin";
+        const int n = 100000;
+        {
+            auto a = DynamicArray<int>::Mapped(path, mapped::Mode::Create);
+            assert(a.IsMapped() && a.GetSize() == 0);
+            for (int i = 0; i < n; ++i) a.PushBack(i);                 // рост через ftruncate + mremap
+            a.Checkpoint();
+            a.Advise(mapped::Advice::Random);
+            a.Advise(mapped::Advice::WillNeed, 10, 100);
+        }
+        {
+            auto a = DynamicArray<int>::Mapped(path);                  // длина из заголовка, данные не читаются
+            assert(a.GetSize() == size_t(n) && a[n - 1] == n - 1);
+            while (a.GetSize() < a.GetCapacity()) a.PushBack(-1);
+            a.PushBack(a[0]);                                          // аргумент в старом отображении
+            assert(a[a.GetSize() - 1] == 0);
+            size_t before = a.GetSize();
+            while (a.GetSize() < a.GetCapacity()) a.PushBack(-2);
+            a.InsertRange(0, a.begin(), a.begin() + 3);                // источник в старом отображении
+            assert(a[0] == 0 && a[2] == 2 && a[3] == 0 && a.GetSize() > before);
+            a.Resize(n + 5);                                           // без Checkpoint: длина пишется при закрытии
+        }
+        {
+            MutableArraySequence<int> m(DynamicArray<int>::Mapped(path));
+            assert(m.GetLength() == size_t(n + 5) && m.Get(3) == 0 && m.Get(n + 2) == n - 1);
+            long long sum = 0;
+            m.ForEach([&](int v) { sum += v; });
+            assert(sum == 3 + (long long)(n - 1) * n / 2 - 2);        // 0,1,2 + исходные 0..n-1 + два -1
+            m.Buffer().Read().Checkpoint(true);
+        }
+        {
+            ImmutableArraySequence<int> im(DynamicArray<int>::Mapped(path, mapped::Mode::ReadOnly));
+            assert(im.GetLength() == size_t(n + 5) && im.Get(n + 4) == -1);
+            MutableArraySequence<int> priv(DynamicArray<int>::Mapped(path, mapped::Mode::ReadOnly));
+            priv.Append(42);                                           // в свою копию страницы, не в файл
+            assert(priv.Buffer().Read().IsMapped());
+            size_t cap = priv.Buffer().Read().GetCapacity();
+            while (priv.GetLength() <= cap) priv.Append(1);            // рост переводит массив в кучу
+            assert(!priv.Buffer().Read().IsMapped() && priv.Get(0) == 0);
+        }
+        assert(DynamicArray<int>::Mapped(path, mapped::Mode::ReadOnly).GetSize() == size_t(n + 5));
+        {
+            auto ro = DynamicArray<int>::Mapped(path, mapped::Mode::ReadOnly);
+            bool rejected = false;
+            try { ro.Advise(mapped::Advice::DontNeed); } catch (const std::invalid_argument&) { rejected = true; }
+            assert(rejected);
+            ro.Advise(mapped::Advice::WillNeed, n + 100, 10);          // за концом — ничего
+        }
+        {
+            MutableArraySequence<int> m(DynamicArray<int>::Mapped(path, mapped::Mode::Create));
+            for (int i = 0; i < 10; ++i) m.Append(i);
+            auto sub = m.GetSubsequence(0, 2);                         // срез и копия файл не делят
+            auto view = SliceView<int>(m, 5, 3);
+            SeqUPtr<int> cl = m.Clone();
+            m.Append(100);                                             // владелец остаётся в файле
+            assert(m.Buffer().Read().IsMapped() && !m.Buffer().IsShared());
+            assert(sub->GetLength() == 3 && sub->Get(2) == 2 && view->Get(0) == 5 && cl->GetLength() == 10);
+            sub->Append(7);
+            m.Append(101);
+            assert(m.GetLength() == 12 && m.Get(3) == 3);
+        }
+        {
+            auto a = DynamicArray<int>::Mapped(path, mapped::Mode::ReadOnly);
+            assert(a.GetSize() == 12 && a[10] == 100 && a[11] == 101);
+        }
+
+        struct Rec { long long id; double v; };
+        bool thrown = false;
+        try { DynamicArray<Rec>::Mapped(path); }
+        catch (const std::runtime_error& e) {                      // в сообщении и размер, и выравнивание
+            thrown = std::string(e.what()).find("4/4, expected 16/8") != std::string::npos;
+        }
+        assert(thrown);
+        {
+            auto r = DynamicArray<Rec>::Mapped(path, mapped::Mode::Create, 16);
+            assert(r.GetCapacity() >= 16);
+            r.PushBack(Rec{ 7, 0.5 });
+        }
+        auto r = DynamicArray<Rec>::Mapped(path, mapped::Mode::Open);
+        assert(r.GetSize() == 1 && r[0].id == 7 && r[0].v == 0.5);
+        thrown = false;
+        try { DynamicArray<int>::Mapped("/nonexistent-dir/x.bin"); } catch (const std::system_error&) { thrown = true; }
+        assert(thrown);
+        std::remove(path.c_str());
+    }
+
+    // --- 6.32 Вывод результата, если все assert-ы прошли ---
     std::cout << "=== Все тесты пройдены успешно! ===\n";
 
     return 0;